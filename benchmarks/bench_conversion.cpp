@@ -0,0 +1,96 @@
+#include "include/bignum.hpp"
+#include "include/bignum_view.hpp"
+#include "benchmarks/bench_util.hpp"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+/// decimal strings of range(0) digits
+static void parse_decimal(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const std::string digits = random_digits(gen, state.range(0));
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(UnsignedBigInt(digits));
+	}
+	state.SetBytesProcessed(state.iterations() * digits.size());
+}
+
+static void format_decimal(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const UnsignedBigInt value(random_digits(gen, state.range(0)));
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(value.to_string());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/// hex strings of range(0) digits, read and written straight off the bits
+static void parse_hex(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const std::string digits = UnsignedBigInt(random_digits(gen, state.range(0))).to_string(16);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(UnsignedBigInt::from_string(digits, 16));
+	}
+	state.SetBytesProcessed(state.iterations() * digits.size());
+}
+
+static void format_hex(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const UnsignedBigInt value(random_digits(gen, state.range(0)));
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(value.to_string(16));
+	}
+	state.SetBytesProcessed(state.iterations() * value.digits() * 16);
+}
+
+/// the binary encoding of values of range(0) decimal digits
+static void serialize(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const UnsignedBigInt value(random_digits(gen, state.range(0)));
+	std::vector<uint8_t> buffer(value.serialized_size());
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(value.serialize(buffer.data()));
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+static void deserialize(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const UnsignedBigInt value(random_digits(gen, state.range(0)));
+	const std::vector<uint8_t> buffer = value.serialize();
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(UnsignedBigInt::deserialize(buffer));
+	}
+	state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+/// compares an encoded value against an equal one without copying it out of the buffer
+static void compare_view(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const UnsignedBigInt value(random_digits(gen, state.range(0)));
+	const std::vector<uint8_t> buffer = value.serialize();
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(UnsignedBigIntView::decode(buffer) == value);
+	}
+	state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+BENCHMARK(parse_decimal)->RangeMultiplier(4)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(format_decimal)->RangeMultiplier(4)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(parse_hex)->RangeMultiplier(4)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(format_hex)->RangeMultiplier(4)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(serialize)->RangeMultiplier(4)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(deserialize)->RangeMultiplier(4)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(compare_view)->RangeMultiplier(4)->Range(64, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
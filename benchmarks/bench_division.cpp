@@ -0,0 +1,52 @@
+#include "include/bignum.hpp"
+#include "benchmarks/bench_util.hpp"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/// 2n / n limb divisions, ranges cover the schoolbook/burnikel-ziegler/newton crossovers
+static void division(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, 2 * limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a.divmod(b));
+	}
+	state.SetComplexityN(limbs);
+}
+
+/// 9n / n limb divisions run several quotient blocks against the same divisor
+static void division_long_quotient(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, 9 * limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a.divmod(b));
+	}
+	state.SetComplexityN(limbs);
+}
+
+/// n limb products at the same sizes, large divisions should stay a small multiple of these
+static void division_reference_multiplication(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a * b);
+	}
+	state.SetComplexityN(limbs);
+}
+
+BENCHMARK(division)->RangeMultiplier(2)->Range(8, 128)->DenseRange(192, 1024, 64)
+	->RangeMultiplier(2)
+	->Range(2048, 1 << 14);
+BENCHMARK(division_long_quotient)->RangeMultiplier(2)->Range(64, 1 << 12);
+BENCHMARK(division_reference_multiplication)->RangeMultiplier(2)->Range(256, 1 << 14);
+
+BENCHMARK_MAIN();
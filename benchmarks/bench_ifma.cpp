@@ -0,0 +1,77 @@
+#include "include/bignum.hpp"
+#include "include/ifma.hpp"
+#include "benchmarks/bench_util.hpp"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/// @brief runs the benchmark on the scalar kernels (range 1 == 0) or the IFMA ones, restoring
+/// the process wide setting afterwards
+class KernelChoice {
+public:
+	explicit KernelChoice(benchmark::State& state)
+		: m_previous(ifma::enabled()) {
+		const bool vector = state.range(1) != 0;
+		if(vector && !ifma::supported()) {
+			state.SkipWithError("the cpu does not run AVX-512 IFMA");
+		}
+		ifma::set_enabled(vector && ifma::supported());
+		state.SetLabel(vector ? "ifma" : "scalar");
+	}
+
+	~KernelChoice() {
+		ifma::set_enabled(m_previous);
+	}
+
+private:
+	bool m_previous;
+};
+
+/// balanced products of the given bit length
+static void multiplication(benchmark::State& state) {
+	KernelChoice choice(state);
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0) / 64;
+	UnsignedBigInt a = random_bignum(gen, limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a * b);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void square(benchmark::State& state) {
+	KernelChoice choice(state);
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0) / 64;
+	UnsignedBigInt a = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a.square());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+/// full size exponent modulo an odd modulus, which runs in montgomery form
+static void modexp(benchmark::State& state) {
+	KernelChoice choice(state);
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0) / 64;
+	UnsignedBigInt base = random_bignum(gen, limbs - 1);
+	UnsignedBigInt exp = random_bignum(gen, limbs);
+	UnsignedBigInt mod = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(base.modulus_exp(exp, mod));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(multiplication)->ArgsProduct({ benchmark::CreateRange(1024, 16384, 2), { 0, 1 } });
+BENCHMARK(square)->ArgsProduct({ benchmark::CreateRange(1024, 16384, 2), { 0, 1 } });
+BENCHMARK(modexp)
+	->ArgsProduct({ benchmark::CreateRange(1024, 16384, 2), { 0, 1 } })
+	->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,36 @@
+#include "include/bignum.hpp"
+#include "benchmarks/bench_util.hpp"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/// full size exponent modulo an odd modulus of the given bit length, as in rsa
+static void modexp_odd(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0) / 64;
+	UnsignedBigInt base = random_bignum(gen, limbs - 1);
+	UnsignedBigInt exp = random_bignum(gen, limbs);
+	UnsignedBigInt mod = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(base.modulus_exp(exp, mod));
+	}
+}
+
+/// the same with an even modulus
+static void modexp_even(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0) / 64;
+	UnsignedBigInt base = random_bignum(gen, limbs - 1);
+	UnsignedBigInt exp = random_bignum(gen, limbs);
+	UnsignedBigInt mod = random_bignum(gen, limbs) + 1;
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(base.modulus_exp(exp, mod));
+	}
+}
+
+BENCHMARK(modexp_odd)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(modexp_even)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
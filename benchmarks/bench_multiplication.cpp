@@ -0,0 +1,111 @@
+#include "include/bignum.hpp"
+#include "include/expression.tpp"
+#include "include/thread_pool.hpp"
+#include "benchmarks/bench_util.hpp"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+/// balanced n x n limb products, ranges cover the schoolbook/karatsuba/toom crossovers
+static void multiplication(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a * b);
+	}
+	state.SetComplexityN(limbs);
+}
+
+/// n x n/8 limb products exercise the chunked unbalanced path
+static void multiplication_unbalanced(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs / 8);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a * b);
+	}
+	state.SetComplexityN(limbs);
+}
+
+/// n limb squares, compared against multiplication they show the saving of the sqr kernels
+static void square(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, limbs);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a.square());
+	}
+	state.SetComplexityN(limbs);
+}
+
+/// a * b + c * d - e with a temporary per operator
+static void multiply_accumulate_eager(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+	UnsignedBigInt c = random_bignum(gen, limbs);
+	UnsignedBigInt d = random_bignum(gen, limbs);
+	UnsignedBigInt e = random_bignum(gen, limbs);
+	UnsignedBigInt result;
+
+	for(auto _ : state) {
+		result = a * b + c * d - e;
+		benchmark::DoNotOptimize(result);
+	}
+	state.SetComplexityN(limbs);
+}
+
+/// the same expression evaluated through the expression templates into one buffer
+static void multiply_accumulate_fused(benchmark::State& state) {
+	using bignum_expr::lazy;
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+	UnsignedBigInt c = random_bignum(gen, limbs);
+	UnsignedBigInt d = random_bignum(gen, limbs);
+	UnsignedBigInt e = random_bignum(gen, limbs);
+	UnsignedBigInt result;
+
+	for(auto _ : state) {
+		bignum_expr::assign(result, lazy(a) * b + lazy(c) * d - e);
+		benchmark::DoNotOptimize(result);
+	}
+	state.SetComplexityN(limbs);
+}
+
+/// balanced products on a pool of range(1) threads with the default grain
+static void multiplication_parallel(benchmark::State& state) {
+	std::mt19937_64 gen(42);
+	const size_t limbs = state.range(0);
+	UnsignedBigInt a = random_bignum(gen, limbs);
+	UnsignedBigInt b = random_bignum(gen, limbs);
+	ThreadPool pool(state.range(1));
+	ParallelScope scope(pool);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(a * b);
+	}
+	state.SetComplexityN(limbs);
+}
+
+BENCHMARK(multiplication)->DenseRange(8, 64, 8)->DenseRange(128, 1024, 64)
+	->RangeMultiplier(2)
+	->Range(2048, 1 << 14);
+BENCHMARK(square)->DenseRange(8, 96, 8)->RangeMultiplier(2)->Range(128, 1 << 14);
+BENCHMARK(multiplication_unbalanced)->RangeMultiplier(2)->Range(256, 1 << 14);
+BENCHMARK(multiplication_parallel)
+	->ArgsProduct({ benchmark::CreateRange(1 << 12, 1 << 20, 4), { 1, 2, 4, 8, 16, 32 } })
+	->UseRealTime()
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(multiply_accumulate_eager)->RangeMultiplier(2)->Range(2, 256);
+BENCHMARK(multiply_accumulate_fused)->RangeMultiplier(2)->Range(2, 256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "include/bignum.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+/// @brief random value of exactly n > 0 limbs
+inline UnsignedBigInt random_bignum(std::mt19937_64& gen, size_t n) {
+	UnsignedBigInt ret = gen() | 1;
+	for(size_t i = 1; i < n; i++) {
+		ret <<= 64;
+		ret += gen();
+	}
+	return ret;
+}
+
+/// @brief n random decimal digits. a leading '0' is replaced by '7', so the value has exactly n
+/// significant digits while its first digit still varies. empty for n = 0
+inline std::string random_digits(std::mt19937_64& gen, size_t n) {
+	std::string ret(n, '0');
+	for(char& digit : ret) {
+		digit = static_cast<char>('0' + gen() % 10);
+	}
+	if(n > 0 && ret[0] == '0') {
+		ret[0] = '7';
+	}
+	return ret;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "bignum.hpp"
+
+#include <vector>
+
+/// @brief reduction modulo a fixed modulus m of k limbs by barrett's method. a precomputed
+/// mu = floor(B^(2k) / m) turns every reduction into two multiplications and at most two
+/// subtractions, three for small moduli where the quotient estimate skips its low columns. this
+/// works for any modulus including even ones
+class BarrettContext {
+public:
+	/// @throws BigNumDivideByZeroException if modulus is zero
+	explicit BarrettContext(const UnsignedBigInt& modulus);
+
+	/// @brief x mod m. inputs of up to 2k limbs, which covers every x < m^2, take the barrett
+	/// path, anything longer falls back to long division
+	UnsignedBigInt reduce(const UnsignedBigInt& x) const;
+
+	/// @brief reduces every value in place, sharing one scratch buffer across the batch
+	void reduce_batch(std::vector<UnsignedBigInt>& values) const;
+
+	/// @brief a * b mod m
+	UnsignedBigInt mul(const UnsignedBigInt& a, const UnsignedBigInt& b) const;
+
+	/// @brief a * a mod m
+	UnsignedBigInt sqr(const UnsignedBigInt& a) const;
+
+	/// @brief base^exp mod m
+	UnsignedBigInt pow(const UnsignedBigInt& base, const UnsignedBigInt& exp) const;
+
+	const UnsignedBigInt& modulus() const noexcept;
+
+private:
+	typedef UnsignedBigInt::base_t base_t;
+	typedef UnsignedBigInt::container container;
+
+	// moduli below this many limbs reduce with half schoolbook products, larger ones with the
+	// full multiplication kernels once karatsuba saves more than the skipped half
+	inline static constexpr size_t TRUNCATED_THRESHOLD = 128;
+
+	/// @brief out[0..k] = x mod m for a 2k limb x, which may carry leading zeros
+	/// @param scratch at least reduce_scratch_size() limbs
+	void reduce_limbs(base_t* out, const base_t* x, base_t* scratch) const;
+
+	/// @brief out[0..k] = x mod m, zero padded
+	void load(base_t* out, const UnsignedBigInt& x) const;
+
+	size_t reduce_scratch_size() const noexcept;
+
+	UnsignedBigInt m_modulus;
+	size_t m_size;
+	container m_mu; // floor(B^(2k) / m), k + 1 limbs unless m = B^(k - 1)
+};
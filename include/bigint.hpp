@@ -0,0 +1,105 @@
+#pragma once
+
+#include "bignum.hpp"
+
+#include <compare>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/// @brief rounding of signed quotients
+enum class DivisionMode {
+	// toward zero like the built in operators, the remainder takes the dividend's sign
+	TRUNCATE,
+	// toward negative infinity, the remainder takes the divisor's sign
+	FLOOR,
+};
+
+/// @brief signed integer as a sign and an UnsignedBigInt magnitude. additions of opposite signs
+/// subtract the magnitudes in place and flip the sign on a final borrow, so no operation needs
+/// a magnitude comparison first or throws on a negative result. zero is never negative
+class BigInt {
+public:
+	// =============================
+	// Section: Constructors
+	// =============================
+	BigInt() noexcept
+		: m_negative(false) { }
+
+	BigInt(int number) noexcept;
+	BigInt(int64_t number) noexcept;
+	BigInt(uint64_t number) noexcept
+		: m_magnitude(number)
+		, m_negative(false) { }
+
+	BigInt(const UnsignedBigInt& magnitude, bool negative = false);
+	BigInt(UnsignedBigInt&& magnitude, bool negative = false) noexcept;
+
+	/// @brief decimal digits with an optional leading '-' or '+'
+	explicit BigInt(const std::string& number);
+
+	BigInt(const BigInt& number) = default;
+	BigInt(BigInt&& number) noexcept = default;
+	BigInt& operator=(const BigInt& number) = default;
+	BigInt& operator=(BigInt&& number) = default;
+
+	// =============================
+	// Section: algebraic operations
+	// =============================
+	BigInt operator-() const&;
+	BigInt operator-() &&;
+
+	BigInt operator+(const BigInt& other) const&;
+	BigInt operator-(const BigInt& other) const&;
+	BigInt operator*(const BigInt& other) const&;
+	BigInt operator/(const BigInt& other) const&;
+	BigInt operator%(const BigInt& other) const&;
+
+	BigInt operator+(const BigInt& other) &&;
+	BigInt operator-(const BigInt& other) &&;
+	BigInt operator*(const BigInt& other) &&;
+	BigInt operator/(const BigInt& other) &&;
+	BigInt operator%(const BigInt& other) &&;
+
+	BigInt& operator+=(const BigInt& other);
+	BigInt& operator-=(const BigInt& other);
+	BigInt& operator*=(const BigInt& other);
+	BigInt& operator/=(const BigInt& other);
+	BigInt& operator%=(const BigInt& other);
+
+	/// @brief quotient and remainder with quotient * divisor + remainder == *this
+	/// @throws BigNumDivideByZeroException if divisor is zero
+	std::pair<BigInt, BigInt> divmod(
+		const BigInt& divisor, DivisionMode mode = DivisionMode::TRUNCATE) const;
+
+	/// @brief flips the sign in place, zero stays zero
+	BigInt& negate() noexcept;
+
+	// =============================
+	// Section: Comparators
+	// =============================
+	std::strong_ordering operator<=>(const BigInt& other) const noexcept;
+	bool operator<(const BigInt& other) const;
+	bool operator>(const BigInt& other) const;
+	bool operator<=(const BigInt& other) const;
+	bool operator>=(const BigInt& other) const;
+	bool operator==(const BigInt& other) const;
+	bool operator!=(const BigInt& other) const;
+
+	/// @return -1, 0 or 1
+	int sign() const noexcept;
+	bool is_negative() const noexcept;
+	const UnsignedBigInt& magnitude() const& noexcept;
+	UnsignedBigInt magnitude() &&;
+
+	std::string to_string() const;
+
+private:
+	/// @brief *this += (negative ? -1 : 1) * magnitude, the core of both + and -
+	void add_signed(const UnsignedBigInt& magnitude, bool negative);
+
+	bool is_zero() const noexcept;
+
+	UnsignedBigInt m_magnitude;
+	bool m_negative;
+};
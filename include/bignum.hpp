@@ -1,14 +1,26 @@
 #pragma once
 
-#include "aligned_alloc.tpp"
+#include "limb_allocator.hpp"
+#include "small_vector.tpp"
 
+#include <bit>
 #include <cassert>
+#include <compare>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+namespace radix_cache {
+class Powers;
+}
+
+class UnsignedBigIntView;
+
 /// @brief immutable container representing unsigned numbers in little endian format
 class UnsignedBigInt {
 public:
@@ -30,22 +42,36 @@ public:
 	UnsignedBigInt(uint64_t number) noexcept
 		: m_digits(1)
 		, m_container(UnsignedBigInt::INITIAL_ALLOCATIONS_SIZE, 0) {
-		// static_assert(sizeof(number) <= HEAP_THRESHOLD * sizeof(base_t));
 		m_container[0] = number;
 	}
 
 	UnsignedBigInt(__uint128_t number) noexcept
 		: m_digits(number & UPPER_MASK_128 ? 2 : 1)
 		, m_container(UnsignedBigInt::INITIAL_ALLOCATIONS_SIZE, 0) {
-		// treat 0th index as pointer to __uint128, setting both at once
-		// without masks or shifts
-		*reinterpret_cast<__uint128_t*>(m_container.data()) = number;
+		m_container[0] = static_cast<base_t>(number);
+		m_container[1] = static_cast<base_t>(number >> 64);
 	}
 
-	/// @brief
-	/// @param number
+	/// @brief parses a string of decimal digits, the empty string being zero. long strings are
+	/// converted by divide and conquer in O(M(n) log n)
+	/// @throws BigNumInvalidDigitException for anything but '0' to '9'
 	UnsignedBigInt(const std::string& number);
 
+	/// @brief parses digits in base 2 to 36, most significant first, with letters of either case
+	/// past 9. the empty string is zero. power of two bases are read in linear time, the others
+	/// like decimal strings
+	/// @throws BigNumInvalidBaseException unless 2 <= base <= 36
+	/// @throws BigNumInvalidDigitException for a character that is not a digit of base
+	static UnsignedBigInt from_string(std::string_view digits, unsigned base = 10);
+
+	UnsignedBigInt(const UnsignedBigInt& number) = default;
+
+	/// @brief takes over the limbs of number, which is left holding zero
+	UnsignedBigInt(UnsignedBigInt&& number) noexcept;
+
+	/// @brief copies the viewed limbs into a value of its own
+	explicit UnsignedBigInt(UnsignedBigIntView view);
+
 	/// @brief
 	/// @param number
 	/// @return
@@ -71,17 +97,29 @@ public:
 	/// @return
 	UnsignedBigInt& operator=(const UnsignedBigInt& number);
 
+	/// @brief takes over the limbs of number, which is left holding zero. limbs from a different
+	/// LimbResource are copied instead
+	UnsignedBigInt& operator=(UnsignedBigInt&& number);
+
 	// =============================
 	// Section: Includes and Imports
 	// =============================
-	UnsignedBigInt operator+(const uint64_t& other) const;
-	UnsignedBigInt operator-(const uint64_t& other) const;
-	UnsignedBigInt operator*(const uint64_t& other) const;
+	// the rvalue overloads compute in the storage of an expiring operand instead of copying it
+	UnsignedBigInt operator+(const uint64_t& other) const&;
+	UnsignedBigInt operator-(const uint64_t& other) const&;
+	UnsignedBigInt operator*(const uint64_t& other) const&;
 	// UnsignedBigInt operator/(const uint64_t& other) const;
-	UnsignedBigInt operator<<(const uint64_t& other) const;
-	UnsignedBigInt operator>>(const uint64_t& other) const;
+	UnsignedBigInt operator<<(const uint64_t& other) const&;
+	UnsignedBigInt operator>>(const uint64_t& other) const&;
+
+	UnsignedBigInt operator+(const uint64_t& other) &&;
+	UnsignedBigInt operator-(const uint64_t& other) &&;
+	UnsignedBigInt operator*(const uint64_t& other) &&;
+	UnsignedBigInt operator<<(const uint64_t& other) &&;
+	UnsignedBigInt operator>>(const uint64_t& other) &&;
 
 	UnsignedBigInt& operator+=(const uint64_t& other);
+	/// @throws BigNumUnderflowException if other > *this, leaving this value unchanged
 	UnsignedBigInt& operator-=(const uint64_t& other);
 	UnsignedBigInt& operator*=(const uint64_t& other);
 	// UnsignedBigInt& operator/=(const uint64_t& other);
@@ -91,29 +129,78 @@ public:
 	// =============================
 	// Section: Includes and Imports
 	// =============================
-	UnsignedBigInt operator+(const UnsignedBigInt& other) const;
-	UnsignedBigInt operator-(const UnsignedBigInt& other) const;
-	UnsignedBigInt operator*(const UnsignedBigInt& other) const;
-	UnsignedBigInt operator/(const UnsignedBigInt& other) const;
-	UnsignedBigInt operator%(const UnsignedBigInt& other) const;
-	UnsignedBigInt operator^(const UnsignedBigInt& other) const;
-	UnsignedBigInt modulus_exp(const UnsignedBigInt& exp, const UnsignedBigInt& mod) const;
+	UnsignedBigInt operator+(const UnsignedBigInt& other) const&;
+	UnsignedBigInt operator-(const UnsignedBigInt& other) const&;
+	UnsignedBigInt operator*(const UnsignedBigInt& other) const&;
+	UnsignedBigInt operator/(const UnsignedBigInt& other) const&;
+	UnsignedBigInt operator%(const UnsignedBigInt& other) const&;
+	UnsignedBigInt operator^(const UnsignedBigInt& other) const&;
+	UnsignedBigInt modulus_exp(const UnsignedBigInt& exp, const UnsignedBigInt& mod) const&;
+	UnsignedBigInt square() const&;
+
+	UnsignedBigInt operator+(const UnsignedBigInt& other) &&;
+	UnsignedBigInt operator-(const UnsignedBigInt& other) &&;
+	UnsignedBigInt operator*(const UnsignedBigInt& other) &&;
+	UnsignedBigInt operator/(const UnsignedBigInt& other) &&;
+	UnsignedBigInt operator%(const UnsignedBigInt& other) &&;
+	UnsignedBigInt operator^(const UnsignedBigInt& other) &&;
+	UnsignedBigInt modulus_exp(const UnsignedBigInt& exp, const UnsignedBigInt& mod) &&;
+	UnsignedBigInt square() &&;
+
+	// addition and multiplication commute, so an expiring right operand is reused as well
+	UnsignedBigInt operator+(UnsignedBigInt&& other) const&;
+	UnsignedBigInt operator*(UnsignedBigInt&& other) const&;
+	UnsignedBigInt operator+(UnsignedBigInt&& other) &&;
+	UnsignedBigInt operator*(UnsignedBigInt&& other) &&;
+
+	/// @brief quotient and remainder of a single division pass
+	/// @throws BigNumDivideByZeroException if divisor is zero
+	std::pair<UnsignedBigInt, UnsignedBigInt> divmod(const UnsignedBigInt& divisor) const;
 	// UnsignedBigInt operator<<(const UnsignedBigInt& other) const;
 	// UnsignedBigInt operator>>(const UnsignedBigInt& other) const;
 
 	UnsignedBigInt& operator+=(const UnsignedBigInt& other);
+	/// @throws BigNumUnderflowException if other > *this, leaving this value unchanged
 	UnsignedBigInt& operator-=(const UnsignedBigInt& other);
 	UnsignedBigInt& operator*=(const UnsignedBigInt& other);
 	UnsignedBigInt& operator/=(const UnsignedBigInt& other);
 	UnsignedBigInt& operator%=(const UnsignedBigInt& other);
 	UnsignedBigInt& operator^=(const UnsignedBigInt& other);
 	UnsignedBigInt& modulus_exp_eq(const UnsignedBigInt& exp, const UnsignedBigInt& mod);
+	/// @brief *this = *this * other mod mod. the product and the quotient stay in workspace
+	/// scratch, only the remainder is copied into this value
+	/// @throws BigNumDivideByZeroException if mod is zero
+	UnsignedBigInt& mulmod_eq(const UnsignedBigInt& other, const UnsignedBigInt& mod);
+	UnsignedBigInt& square_eq();
+
+	/// @brief *this -= other in a single borrow chain, for callers that branch on the sign
+	/// instead of catching BigNumUnderflowException
+	/// @return false if other > *this, leaving this value unchanged
+	[[nodiscard]] bool try_sub(const UnsignedBigInt& other) noexcept;
+	[[nodiscard]] bool try_sub(const uint64_t& other) noexcept;
+
+	/// @brief *this += a * b. short operands are accumulated row by row straight into this
+	/// value's limbs, longer ones go through one product buffer
+	UnsignedBigInt& addmul_eq(const UnsignedBigInt& a, const UnsignedBigInt& b);
+
+	/// @brief *this -= a * b, accumulated the same way as addmul_eq
+	/// @throws BigNumUnderflowException if a * b > *this, leaving this value unchanged
+	UnsignedBigInt& submul_eq(const UnsignedBigInt& a, const UnsignedBigInt& b);
+
+	// operands viewed in a buffer are read in place. only limbs that are misaligned, stored big
+	// endian or overlapping this value are first copied to workspace scratch
+	UnsignedBigInt& operator+=(UnsignedBigIntView other);
+	/// @throws BigNumUnderflowException if other > *this, leaving this value unchanged
+	UnsignedBigInt& operator-=(UnsignedBigIntView other);
+	UnsignedBigInt& operator*=(UnsignedBigIntView other);
 	// UnsignedBigInt& operator<<=(const UnsignedBigInt& other);
 	// UnsignedBigInt& operator>>=(const UnsignedBigInt& other);
 
 	// =============================
 	// Section: Comparators
 	// =============================
+	/// @brief orders by limb count and then limb by limb from the top, one scan at most
+	std::strong_ordering operator<=>(const UnsignedBigInt& other) const noexcept;
 	bool operator<(const UnsignedBigInt& other) const;
 	bool operator>(const UnsignedBigInt& other) const;
 	bool operator<=(const UnsignedBigInt& other) const;
@@ -124,21 +211,69 @@ public:
 	size_t digits() const noexcept;
 	size_t most_significant_bit() const noexcept;
 	void set_bit(size_t idx, bool on) noexcept;
-
-	std::string to_string() const;
+	bool get_bit(size_t idx) const noexcept;
+
+	/// @brief digits in base 2 to 36 without leading zeros, lowercase letters past 9. power of
+	/// two bases are read off the bits in linear time, other long values are converted by divide
+	/// and conquer in O(M(n) log n)
+	/// @throws BigNumInvalidBaseException unless 2 <= base <= 36
+	std::string to_string(unsigned base = 10) const;
+	/// @brief every limb as 64 binary digits followed by a space, most significant limb first
 	std::string to_bitstring() const;
 
+	// =============================
+	// Section: binary encoding
+	// =============================
+	// version 1 of the encoding is one version byte, the limb count n as a varint of seven bits
+	// per byte, low groups first, and then the n limbs least significant first, each as eight
+	// little endian bytes. zero has no limbs, and the top limb of any other value is nonzero
+	inline static constexpr uint8_t ENCODING_VERSION = 1;
+
+	/// @brief bytes serialize writes for this value
+	size_t serialized_size() const noexcept;
+
+	/// @brief writes the binary encoding of this value to out
+	/// @param out at least serialized_size() bytes
+	/// @return the bytes written
+	size_t serialize(uint8_t* out) const noexcept;
+
+	std::vector<uint8_t> serialize() const;
+
+	/// @brief reads one encoded value from the front of bytes
+	/// @param consumed if given, receives the bytes the value took, so a buffer of values can
+	/// be read back to back
+	/// @throws BigNumInvalidEncodingException for a truncated, non canonical or unknown encoding
+	static UnsignedBigInt deserialize(std::span<const uint8_t> bytes, size_t* consumed = nullptr);
+
+	/// @brief the value as bytes without leading zeros, like mpz_export with whole byte words.
+	/// zero has no bytes
+	std::vector<uint8_t> to_bytes(std::endian order = std::endian::big) const;
+
+	/// @brief the value of bytes in the given order, any leading zero bytes included
+	static UnsignedBigInt from_bytes(
+		std::span<const uint8_t> bytes, std::endian order = std::endian::big);
+
 	~UnsignedBigInt() = default;
 
 private:
+	// fixed modulus contexts run their own limb kernels on the container
+	friend class MontgomeryContext;
+	friend class BarrettContext;
+	// the signed type adds and subtracts magnitudes on the limbs directly
+	friend class BigInt;
+	// views of a value point at its limbs
+	friend class UnsignedBigIntView;
+	// tests run the division kernels below their dispatch thresholds
+	friend class DivisionKernels;
+
+	// values up to this many limbs live inside the object and never touch the heap
+	inline static constexpr size_t INLINE_LIMBS = 8;
+
 	typedef uint64_t base_t;
 	typedef __uint128_t carry_t;
-	typedef std::vector<base_t, AlignedAllocator<base_t>> container;
-
-	// class container {
-	// 	std::unique_ptr<base_t[]> m_digits;
-	// 	size_t m_capacity;
-	// };
+	// heap limbs come from the thread's current LimbResource, the pool unless an ArenaScope is
+	// active
+	typedef SmallVector<base_t, INLINE_LIMBS, LimbAllocator<base_t>> container;
 
 	inline static constexpr uint64_t MAX_U64_VALUE = std::numeric_limits<uint64_t>::max();
 	inline static constexpr uint64_t LOWER_MASK_64 = 0x00000000FFFFFFFFull;
@@ -149,13 +284,194 @@ private:
 	inline static constexpr __uint128_t UPPER_MASK_128 =
 		static_cast<__uint128_t>(0xFFFFFFFFFFFFFFFF) << 64;
 
-	// inline static constexpr size_t KARATSUBA_THRESHOLD = 30;
-	// inline static constexpr size_t FFT_THRESHOLD = 50000;
+	// operand sizes (in limbs) at which balanced multiplication moves up to the next algorithm,
+	// measured with benchmarks/bench_multiplication.cpp
+	inline static constexpr size_t KARATSUBA_THRESHOLD = 32;
+	inline static constexpr size_t TOOM3_THRESHOLD = 192;
+	inline static constexpr size_t TOOM4_THRESHOLD = 512;
+	inline static constexpr size_t FFT_THRESHOLD = 4096;
+	// on cpus with AVX-512 IFMA (see ifma.hpp) products of IFMA_THRESHOLD limbs up to
+	// IFMA_KARATSUBA_THRESHOLD run on the vector kernel, which then is also the base case the
+	// recursive algorithms bottom out in. squares take the same path
+	inline static constexpr size_t IFMA_THRESHOLD = 24;
+	inline static constexpr size_t IFMA_KARATSUBA_THRESHOLD = 512;
+	// squaring does half the work of a product below karatsuba, so it switches later
+	inline static constexpr size_t SQR_KARATSUBA_THRESHOLD = 48;
+	static_assert(SQR_KARATSUBA_THRESHOLD >= KARATSUBA_THRESHOLD,
+				  "squaring scratch sizes are bounded by the multiplication ones");
+	// divisions whose quotient and divisor both reach these many limbs move from schoolbook
+	// long division to burnikel-ziegler and then to a newton reciprocal, measured with
+	// benchmarks/bench_division.cpp. burnikel-ziegler stays ahead up to at least 2^18 limbs
+	inline static constexpr size_t DIV_BZ_THRESHOLD = 96;
+	inline static constexpr size_t DIV_NEWTON_THRESHOLD = 1 << 19;
+	// reciprocals of fewer limbs than this come from one long division, longer ones from a
+	// newton step on a reciprocal of half the precision
+	inline static constexpr size_t RECIPROCAL_BASE_THRESHOLD = 32;
+	// strings of more digits than this are split in two and recombined through the
+	// multiplication kernels, measured in decimal with benchmarks/bench_conversion.cpp
+	inline static constexpr size_t PARSE_DC_THRESHOLD = 1200;
+	// values of more limbs than this are printed by splitting them at a power of the base
+	inline static constexpr size_t FORMAT_DC_THRESHOLD = 32;
 	inline static constexpr size_t INITIAL_ALLOCATIONS_SIZE = 8;
-
-	// inline static constexpr size_t HEAP_THRESHOLD = sizeof(container) / sizeof(base_t);
+	static_assert(INITIAL_ALLOCATIONS_SIZE <= INLINE_LIMBS,
+				  "constructing a value must not allocate");
 	// inline static constexpr carry_t STORAGE_MASK = std::numeric_limits<base_t>::max();
 
+	// =============================
+	// Section: limb kernels
+	// =============================
+	// kernels operate on raw little endian limb spans (see limbs.hpp for the primitives they are
+	// built from). outputs must be large enough to hold the full result and never alias inputs.
+	// the operators take their products and scratch from current_workspace() (workspace.hpp)
+
+	/// @brief out[0..an+bn] = a * b using the O(n*m) schoolbook method
+	static void mul_schoolbook(base_t* out, const base_t* a, size_t an, const base_t* b, size_t bn);
+
+	/// @brief out[0..2n] = a * b for two n limb operands using recursive karatsuba
+	/// @param scratch at least karatsuba_scratch_size(n) limbs
+	static void mul_karatsuba(
+		base_t* out, const base_t* a, const base_t* b, size_t n, base_t* scratch);
+
+	/// @brief out[0..2n] = a * b for two n limb operands, 3-way split evaluated at 0, 1, -1, 2, inf
+	/// @param scratch at least toom3_scratch_size(n) limbs
+	static void mul_toom3(
+		base_t* out, const base_t* a, const base_t* b, size_t n, base_t* scratch);
+
+	/// @brief out[0..2n] = a * b for two n limb operands, 4-way split evaluated at
+	/// 0, 1, -1, 2, -2, 1/2, inf
+	/// @param scratch at least toom4_scratch_size(n) limbs
+	static void mul_toom4(
+		base_t* out, const base_t* a, const base_t* b, size_t n, base_t* scratch);
+
+	/// @brief out[0..an+bn] = a * b by a three prime number theoretic transform with crt
+	/// recombination. the transform buffers come from the current workspace. when a and b are
+	/// the same span only one forward transform per prime is done
+	static void mul_fft(base_t* out, const base_t* a, size_t an, const base_t* b, size_t bn);
+
+	/// @brief one of the balanced products a recursive kernel splits its product into
+	struct Subproduct {
+		base_t* out;
+		const base_t* a;
+		const base_t* b;
+		size_t n;
+	};
+
+	/// @brief out = a * b for every subproduct. inside a ParallelScope (thread_pool.hpp), when
+	/// the product being split has at least the grain of limbs, all but the first run as tasks
+	/// on the pool with scratch from the workspace of the thread running them
+	/// @param n limbs of the operands of the product being split
+	/// @param scratch at least mul_n_scratch_size() of the largest subproduct
+	static void mul_subproducts(const Subproduct* products, size_t count, size_t n,
+								base_t* scratch);
+
+	/// @brief whether products whose shorter operand has n limbs go to the IFMA kernel
+	static bool ifma_base_case(size_t n) noexcept;
+
+	/// @brief out[0..2n] = a * b for two n limb operands, picking the fastest balanced kernel.
+	/// forwards to sqr_n when a and b are the same span
+	/// @param scratch at least mul_n_scratch_size(n) limbs
+	static void mul_n(
+		base_t* out, const base_t* a, const base_t* b, size_t n, base_t* scratch);
+
+	/// @brief out[0..2n] = a^2, computing each off diagonal product once and doubling
+	static void sqr_schoolbook(base_t* out, const base_t* a, size_t n);
+
+	/// @brief out[0..2n] = a^2 from the three half size squares a0^2, a1^2 and (a0 - a1)^2
+	/// @param scratch at least karatsuba_scratch_size(n) limbs
+	static void sqr_karatsuba(base_t* out, const base_t* a, size_t n, base_t* scratch);
+
+	/// @brief out[0..2n] = a^2, picking the fastest squaring kernel. the toom kernels square
+	/// when both operands are the same span
+	/// @param scratch at least mul_n_scratch_size(n) limbs, which bounds every squaring path
+	static void sqr_n(base_t* out, const base_t* a, size_t n, base_t* scratch);
+
+	/// @brief out[0..an+bn] = a * b, dispatching on operand size. requires an >= bn
+	/// @param scratch at least mul_scratch_size(an, bn) limbs
+	static void mul_limbs(
+		base_t* out, const base_t* a, size_t an, const base_t* b, size_t bn, base_t* scratch);
+
+	/// @brief knuth's algorithm d. q[0..nn-dn] = n / d and n[0..dn] = n mod d for a normalized
+	/// divisor (most significant bit set) of dn >= 2 limbs, requires nn >= dn
+	/// @return the most significant quotient limb, 0 or 1
+	static base_t div_schoolbook(base_t* q, base_t* n, size_t nn, const base_t* d, size_t dn);
+
+	/// @brief burnikel-ziegler division of a 2n limb numerator by an n limb normalized
+	/// divisor, with the same contract as div_schoolbook. each half of the quotient comes from
+	/// a recursive division by the divisor's top half and one multiplication fixing it up
+	/// @param scratch at least div_bz_n_scratch_size(n) limbs
+	static base_t div_bz_n(base_t* q, base_t* n, const base_t* d, size_t dn, base_t* scratch);
+
+	/// @brief div_bz_n for quotients shorter than the divisor, nn - dn < dn
+	static base_t div_bz_short(
+		base_t* q, base_t* n, size_t nn, const base_t* d, size_t dn, base_t* scratch);
+
+	/// @brief same contract as div_schoolbook, dividing in blocks of dn quotient limbs
+	/// @param scratch at least div_bz_scratch_size(nn, dn) limbs
+	static base_t div_bz(
+		base_t* q, base_t* n, size_t nn, const base_t* d, size_t dn, base_t* scratch);
+
+	/// @brief fixed point reciprocal of the top t limbs of a normalized divisor d by newton
+	/// iteration. with dt = floor(d / B^(dn - t)) + 1 the result x satisfies
+	/// B^(2t) / dt - 2 <= x <= B^(2t) / dt
+	static UnsignedBigInt reciprocal(const UnsignedBigInt& d, size_t t);
+
+	/// @brief divmod for large operands, the quotient comes from multiplications by a
+	/// reciprocal of the divisor followed by a small correction
+	std::pair<UnsignedBigInt, UnsignedBigInt> divmod_newton(const UnsignedBigInt& divisor) const;
+
+	/// @brief value of the n limbs at limbs, which may carry leading zeros
+	static UnsignedBigInt from_limbs(const base_t* limbs, size_t n);
+
+	// =============================
+	// Section: radix conversion
+	// =============================
+
+	/// @brief replaces the value, which must be zero, with the one digits spell in base
+	void parse(std::string_view digits, unsigned base);
+
+	/// @brief limbs holding any value of digits digits in base, plus the slack the recursive
+	/// parser's products need
+	static size_t radix_limbs(size_t digits, unsigned base) noexcept;
+
+	/// @brief out = the value of the n digits at digits in base, most significant first. with m
+	/// digits to a leaf limb, long strings are split so that the low part holds m * 2^k digits,
+	/// and the halves are combined as high * base^(m * 2^k) + low
+	/// @param out at least radix_limbs(n, base) limbs
+	/// @param powers radix_cache::get(base, n), the levels base^(m * 2^k) below base^n
+	/// @return limbs of the result without leading zeros, at least one
+	/// @throws BigNumInvalidDigitException for a character that is not a digit of base
+	static size_t parse_radix(base_t* out, const char* digits, size_t n, unsigned base,
+							  const radix_cache::Powers& powers);
+
+	/// @brief writes value as exactly width digits in base, zero padded, to out. large values
+	/// are divided by base^(m * 2^k) for the largest block shorter than width, and the quotient
+	/// and the remainder printed side by side
+	/// @param value below base^width
+	/// @param powers radix_cache::get(base, width)
+	static void format_radix(char* out, size_t width, const UnsignedBigInt& value, unsigned base,
+							 const radix_cache::Powers& powers);
+
+	static size_t karatsuba_scratch_size(size_t n) noexcept;
+	static size_t toom3_scratch_size(size_t n) noexcept;
+	static size_t toom4_scratch_size(size_t n) noexcept;
+	static size_t mul_n_scratch_size(size_t n) noexcept;
+	static size_t mul_scratch_size(size_t an, size_t bn) noexcept;
+	static size_t div_bz_n_scratch_size(size_t n) noexcept;
+	static size_t div_bz_short_scratch_size(size_t nn, size_t dn) noexcept;
+	static size_t div_bz_scratch_size(size_t nn, size_t dn) noexcept;
+
+	/// @brief drops leading zero limbs from m_digits, keeping at least one
+	void normalize() noexcept;
+
+	// the cores of +=, -= and *= on the n limbs at b. b must not lie in this value's container
+	// when it may grow, that is for the addition
+	UnsignedBigInt& add_limbs_eq(const base_t* b, size_t n);
+	[[nodiscard]] bool try_sub_limbs(const base_t* b, size_t n) noexcept;
+	UnsignedBigInt& mul_limbs_eq(const base_t* b, size_t n);
+
+	/// @brief resets a moved from value to zero
+	void clear_moved_from() noexcept;
+
 	size_t m_digits;
 	container m_container;
 };
@@ -166,6 +482,24 @@ class BigNumDivideByZeroException : public std::exception {
 	}
 };
 
+class BigNumInvalidBaseException : public std::exception {
+	const char* what() const noexcept override {
+		return "base must be between 2 and 36";
+	}
+};
+
+class BigNumInvalidDigitException : public std::exception {
+	const char* what() const noexcept override {
+		return "number contains a character that is not a digit";
+	}
+};
+
+class BigNumInvalidEncodingException : public std::exception {
+	const char* what() const noexcept override {
+		return "binary encoding is truncated, not canonical or of an unknown version";
+	}
+};
+
 class BigNumUnderflowException : public std::exception {
 private:
 	std::string _error_msg;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "bignum.hpp"
+
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+/// @brief read only view of a value's limbs, either those of an UnsignedBigInt or little endian
+/// limbs straight in a byte buffer, such as one holding a received encoding. the viewed memory
+/// must outlive the view and stay unchanged while it is used
+class UnsignedBigIntView {
+public:
+	UnsignedBigIntView(const UnsignedBigInt& value) noexcept
+		: UnsignedBigIntView(value.m_container.data(), value.m_digits) { }
+
+	/// @brief view of the n limbs at bytes, each eight little endian bytes at any alignment.
+	/// leading zero limbs are allowed
+	UnsignedBigIntView(const void* bytes, size_t n) noexcept
+		: m_bytes(static_cast<const unsigned char*>(bytes))
+		, m_size(n)
+		, m_digits(n) {
+		while(m_digits > 1 && limb(m_digits - 1) == 0) {
+			m_digits--;
+		}
+		if(m_digits == 0) {
+			m_digits = 1;
+		}
+	}
+
+	/// @brief views the limbs of the encoded value at the front of bytes, see
+	/// UnsignedBigInt::serialize. the limbs are not copied
+	/// @param consumed if given, receives the bytes the encoding took
+	/// @throws BigNumInvalidEncodingException for a truncated, non canonical or unknown encoding
+	static UnsignedBigIntView decode(std::span<const uint8_t> bytes, size_t* consumed = nullptr);
+
+	/// @brief limbs without leading zeros, one for zero, like UnsignedBigInt::digits
+	size_t digits() const noexcept {
+		return m_digits;
+	}
+
+	/// @brief limb i, zero past the stored ones
+	uint64_t limb(size_t i) const noexcept {
+		if(i >= m_size) {
+			return 0;
+		}
+		uint64_t ret;
+		std::memcpy(&ret, m_bytes + 8 * i, sizeof(ret));
+		if constexpr(std::endian::native == std::endian::big) {
+			ret = __builtin_bswap64(ret);
+		}
+		return ret;
+	}
+
+	/// @brief the digits() limbs when they can be read in place: stored, aligned and in native
+	/// order. nullptr otherwise, and the limbs must be loaded with limb()
+	const uint64_t* data() const noexcept {
+		const bool aligned = reinterpret_cast<uintptr_t>(m_bytes) % alignof(uint64_t) == 0;
+		if(std::endian::native != std::endian::little || !aligned || m_size == 0) {
+			return nullptr;
+		}
+		return reinterpret_cast<const uint64_t*>(m_bytes);
+	}
+
+	/// @brief whether the viewed limbs overlap the n bytes at other
+	bool overlaps(const void* other, size_t n) const noexcept {
+		const auto begin = reinterpret_cast<uintptr_t>(other);
+		const auto bytes = reinterpret_cast<uintptr_t>(m_bytes);
+		return bytes < begin + n && begin < bytes + 8 * m_size;
+	}
+
+	/// @brief orders by limb count and then limb by limb from the top, like UnsignedBigInt
+	std::strong_ordering operator<=>(const UnsignedBigIntView& other) const noexcept;
+	bool operator==(const UnsignedBigIntView& other) const noexcept;
+
+private:
+	const unsigned char* m_bytes;
+	size_t m_size; // limbs stored at m_bytes
+	size_t m_digits;
+};
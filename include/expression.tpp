@@ -0,0 +1,183 @@
+#pragma once
+
+#include "bignum.hpp"
+
+#include <type_traits>
+
+/// @brief opt in expression templates over UnsignedBigInt. once an operand is wrapped in lazy(),
+/// +, -, * and % build an expression tree instead of computing temporaries, and eval() or
+/// assign() evaluate the whole tree into one destination. sums and differences of products
+/// become addmul_eq / submul_eq on that destination and (a * b) % m becomes mulmod_eq, which
+/// reduces the product in workspace scratch. trees hold references to their operands, so
+/// evaluate them within the full expression that built them
+namespace bignum_expr {
+
+// ============================================================================
+// Section: expression nodes
+// ============================================================================
+template <typename E>
+struct Expr {
+	const E& self() const noexcept {
+		return static_cast<const E&>(*this);
+	}
+};
+
+/// @brief leaf referring to an existing value
+struct Terminal : Expr<Terminal> {
+	explicit Terminal(const UnsignedBigInt& value) noexcept
+		: value(value) { }
+
+	bool references(const UnsignedBigInt* x) const noexcept {
+		return &value == x;
+	}
+
+	const UnsignedBigInt& value;
+};
+
+struct AddOp { };
+struct SubOp { };
+struct MulOp { };
+struct ModOp { };
+
+template <typename Op, typename L, typename R>
+struct Binary : Expr<Binary<Op, L, R>> {
+	Binary(const L& lhs, const R& rhs)
+		: lhs(lhs)
+		, rhs(rhs) { }
+
+	bool references(const UnsignedBigInt* x) const noexcept {
+		return lhs.references(x) || rhs.references(x);
+	}
+
+	L lhs;
+	R rhs;
+};
+
+template <typename E>
+inline constexpr bool is_product = false;
+template <typename L, typename R>
+inline constexpr bool is_product<Binary<MulOp, L, R>> = true;
+
+/// @brief starts an expression tree at x
+inline Terminal lazy(const UnsignedBigInt& x) noexcept {
+	return Terminal(x);
+}
+
+// ============================================================================
+// Section: operators
+// ============================================================================
+// every operator accepts two expressions or an expression and a plain value on either side,
+// two plain values keep using the eager UnsignedBigInt operators
+#define BIGNUM_EXPR_OPERATOR(symbol, Op)                                                        \
+	template <typename L, typename R>                                                           \
+	Binary<Op, L, R> operator symbol(const Expr<L>& lhs, const Expr<R>& rhs) {                  \
+		return Binary<Op, L, R>(lhs.self(), rhs.self());                                        \
+	}                                                                                           \
+	template <typename L>                                                                       \
+	Binary<Op, L, Terminal> operator symbol(const Expr<L>& lhs, const UnsignedBigInt& rhs) {    \
+		return Binary<Op, L, Terminal>(lhs.self(), Terminal(rhs));                              \
+	}                                                                                           \
+	template <typename R>                                                                       \
+	Binary<Op, Terminal, R> operator symbol(const UnsignedBigInt& lhs, const Expr<R>& rhs) {    \
+		return Binary<Op, Terminal, R>(Terminal(lhs), rhs.self());                              \
+	}
+
+BIGNUM_EXPR_OPERATOR(+, AddOp)
+BIGNUM_EXPR_OPERATOR(-, SubOp)
+BIGNUM_EXPR_OPERATOR(*, MulOp)
+BIGNUM_EXPR_OPERATOR(%, ModOp)
+
+#undef BIGNUM_EXPR_OPERATOR
+
+// ============================================================================
+// Section: evaluation
+// ============================================================================
+namespace detail {
+
+inline void eval_into(UnsignedBigInt& dest, const Terminal& e);
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<AddOp, L, R>& e);
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<SubOp, L, R>& e);
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<MulOp, L, R>& e);
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<ModOp, L, R>& e);
+
+/// @brief leaves are used in place, inner nodes are evaluated into a temporary
+inline const UnsignedBigInt& operand(const Terminal& e) noexcept {
+	return e.value;
+}
+template <typename E>
+UnsignedBigInt operand(const Expr<E>& e) {
+	UnsignedBigInt ret;
+	eval_into(ret, e.self());
+	return ret;
+}
+
+inline void eval_into(UnsignedBigInt& dest, const Terminal& e) {
+	dest = e.value;
+}
+
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<AddOp, L, R>& e) {
+	if constexpr(is_product<R>) {
+		eval_into(dest, e.lhs);
+		dest.addmul_eq(operand(e.rhs.lhs), operand(e.rhs.rhs));
+	} else if constexpr(is_product<L>) {
+		eval_into(dest, e.rhs);
+		dest.addmul_eq(operand(e.lhs.lhs), operand(e.lhs.rhs));
+	} else {
+		eval_into(dest, e.lhs);
+		dest += operand(e.rhs);
+	}
+}
+
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<SubOp, L, R>& e) {
+	eval_into(dest, e.lhs);
+	if constexpr(is_product<R>) {
+		dest.submul_eq(operand(e.rhs.lhs), operand(e.rhs.rhs));
+	} else {
+		dest -= operand(e.rhs);
+	}
+}
+
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<MulOp, L, R>& e) {
+	eval_into(dest, e.lhs);
+	dest *= operand(e.rhs);
+}
+
+template <typename L, typename R>
+void eval_into(UnsignedBigInt& dest, const Binary<ModOp, L, R>& e) {
+	if constexpr(is_product<L>) {
+		eval_into(dest, e.lhs.lhs);
+		dest.mulmod_eq(operand(e.lhs.rhs), operand(e.rhs));
+	} else {
+		eval_into(dest, e.lhs);
+		dest %= operand(e.rhs);
+	}
+}
+
+} // namespace detail
+
+/// @brief value of the expression
+template <typename E>
+UnsignedBigInt eval(const Expr<E>& e) {
+	UnsignedBigInt ret;
+	detail::eval_into(ret, e.self());
+	return ret;
+}
+
+/// @brief dest = e, reusing dest's storage unless e reads dest itself
+template <typename E>
+void assign(UnsignedBigInt& dest, const Expr<E>& e) {
+	if(e.self().references(&dest)) {
+		dest = eval(e);
+	} else {
+		detail::eval_into(dest, e.self());
+	}
+}
+
+} // namespace bignum_expr
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief multiplication kernels for cpus with AVX-512 IFMA. vpmadd52luq and vpmadd52huq add
+/// the low and the high 52 bits of eight 52 x 52 bit products to eight 64 bit lanes, so
+/// operands are repacked into 52 bit limbs and whole rows of partial products are summed in
+/// the vector lanes, leaving the carries for one pass at the end
+namespace ifma {
+
+/// @brief true if the cpu and the os run AVX-512 IFMA, detected once
+bool supported() noexcept;
+
+/// @brief whether the multiplication paths pick these kernels. starts out as supported(), and
+/// may be turned off to run the scalar kernels instead
+bool enabled() noexcept;
+
+/// @brief turns the kernels on or off for the whole process, turning them on requires
+/// supported(). not synchronized with running multiplications
+void set_enabled(bool enable) noexcept;
+
+/// @brief 52 bit limbs holding n 64 bit limbs
+constexpr size_t limbs52(size_t n) noexcept {
+	return (64 * n + 51) / 52;
+}
+
+/// @brief every lane sums at most two products per limb of the shorter operand, which stays
+/// below 2^64 for up to 2047 52 bit limbs
+inline constexpr size_t MAX_MUL_LIMBS = 1024;
+
+/// @brief lanes pick up four products per limb of the modulus before they reach the bottom and
+/// are retired, which stays below 2^64 for up to 1023 52 bit limbs
+inline constexpr size_t MAX_MONTGOMERY_LIMBS = 512;
+
+/// @brief out[0..m] = in[0..n] in 52 bit limbs, zero padded
+void pack52(uint64_t* out, size_t m, const uint64_t* in, size_t n) noexcept;
+
+/// @brief out[0..n] = in[0..m] from normalized 52 bit limbs, truncated or zero padded
+void unpack52(uint64_t* out, size_t n, const uint64_t* in, size_t m) noexcept;
+
+/// @brief out[0..an + bn] = a * b on 64 bit limbs, requires supported() and
+/// 0 < bn <= an, bn <= MAX_MUL_LIMBS. temporaries come from the current workspace
+void mul(uint64_t* out, const uint64_t* a, size_t an, const uint64_t* b, size_t bn);
+
+/// @brief montgomery multiplication modulo an odd N in radix 2^52 with R = 2^(52m), where m is
+/// the 52 bit limb count of N. values are held as size() 52 bit limbs, a multiple of the eight
+/// lanes with the limbs above m zero
+class Montgomery {
+public:
+	Montgomery() = default;
+
+	/// @brief requires supported() and an odd modulus of n <= MAX_MONTGOMERY_LIMBS 64 bit limbs
+	/// @param r2 R^2 mod N in n 64 bit limbs
+	Montgomery(const uint64_t* modulus, const uint64_t* r2, size_t n);
+
+	/// @brief limbs of a value, zero for a default constructed context
+	size_t size() const noexcept;
+
+	/// @brief out = x * R mod N for x below N in 64 bit limbs, n of them
+	void to_mont(uint64_t* out, const uint64_t* x, size_t n) const;
+
+	/// @brief out[0..n] = x / R mod N in 64 bit limbs
+	void from_mont(uint64_t* out, size_t n, const uint64_t* x) const;
+
+	/// @brief out = a * b / R mod N for values below N, out may alias a or b
+	void mul(uint64_t* out, const uint64_t* a, const uint64_t* b) const;
+
+private:
+	std::vector<uint64_t> m_modulus;
+	std::vector<uint64_t> m_r2; // R^2 mod N
+	uint64_t m_inverse = 0; // -N^-1 mod 2^52
+	size_t m_limbs = 0;
+	size_t m_size = 0;
+};
+
+} // namespace ifma
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// ============================================================================
+// Section: memory resources
+// ============================================================================
+
+/// @brief source of 64 byte aligned blocks for limb storage, in the style of
+/// std::pmr::memory_resource. containers remember the resource they allocated from and give
+/// their blocks back to it
+class LimbResource {
+public:
+	virtual ~LimbResource() = default;
+
+	/// @param bytes a positive multiple of 64
+	virtual void* allocate(size_t bytes) = 0;
+	virtual void deallocate(void* ptr, size_t bytes) noexcept = 0;
+};
+
+/// @brief default resource. blocks are rounded up to power of two size classes and recycled
+/// through free lists private to each thread, so steady state allocation takes no lock. a block
+/// may be freed on any thread and joins that thread's lists. blocks above the largest class go
+/// straight to std::aligned_alloc
+class LimbPool final : public LimbResource {
+public:
+	inline static constexpr size_t MIN_BLOCK = 64;
+	inline static constexpr size_t MAX_BLOCK = 64 * 1024;
+	// per thread and size class, so an idle thread holds at most a few MiB
+	inline static constexpr size_t MAX_CACHED_BLOCKS = 32;
+
+	void* allocate(size_t bytes) override;
+	void deallocate(void* ptr, size_t bytes) noexcept override;
+
+	/// @brief frees every block cached by the calling thread
+	static void trim() noexcept;
+
+	/// @brief the process wide pool, its state lives in thread local free lists
+	static LimbPool& instance() noexcept;
+};
+
+/// @brief bump allocator for a whole computation. deallocation is a no-op except for the most
+/// recent block, and every block goes away at once on release() or destruction
+class LimbArena final : public LimbResource {
+public:
+	inline static constexpr size_t MIN_CHUNK = 64 * 1024;
+
+	LimbArena() = default;
+	LimbArena(const LimbArena&) = delete;
+	LimbArena& operator=(const LimbArena&) = delete;
+	~LimbArena() override;
+
+	void* allocate(size_t bytes) override;
+	void deallocate(void* ptr, size_t bytes) noexcept override;
+
+	/// @brief frees every chunk. values still pointing into the arena must be gone by then
+	void release() noexcept;
+
+	/// @brief bytes handed out since the last release, less blocks that were handed back
+	size_t bytes_used() const noexcept;
+
+private:
+	struct Chunk {
+		char* data;
+		size_t size;
+	};
+
+	std::vector<Chunk> m_chunks;
+	char* m_cursor = nullptr;
+	char* m_end = nullptr;
+	char* m_last = nullptr;
+	size_t m_used = 0;
+};
+
+/// @brief routes the calling thread's new limb containers to an arena while in scope. scopes
+/// nest, and values copied out of the scope after it ends allocate from the outer resource.
+/// values constructed inside the scope must not outlive the arena
+class ArenaScope {
+public:
+	explicit ArenaScope(LimbArena& arena) noexcept;
+	ArenaScope(const ArenaScope&) = delete;
+	ArenaScope& operator=(const ArenaScope&) = delete;
+	~ArenaScope();
+
+private:
+	LimbResource* m_previous;
+};
+
+/// @brief resource picked up by containers constructed on the calling thread
+LimbResource* current_limb_resource() noexcept;
+
+// ============================================================================
+// Section: allocator
+// ============================================================================
+
+/// @brief stateful allocator forwarding to a LimbResource, by default the one current on the
+/// constructing thread
+template <typename T>
+class LimbAllocator {
+public:
+	using value_type = T;
+
+	LimbAllocator() noexcept
+		: m_resource(current_limb_resource()) { }
+
+	explicit LimbAllocator(LimbResource* resource) noexcept
+		: m_resource(resource) { }
+
+	template <typename U>
+	LimbAllocator(const LimbAllocator<U>& other) noexcept
+		: m_resource(other.resource()) { }
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(m_resource->allocate(block_size(n)));
+	}
+
+	void deallocate(T* ptr, size_t n) noexcept {
+		m_resource->deallocate(ptr, block_size(n));
+	}
+
+	LimbResource* resource() const noexcept {
+		return m_resource;
+	}
+
+	bool operator==(const LimbAllocator& other) const noexcept {
+		return m_resource == other.m_resource;
+	}
+
+	bool operator!=(const LimbAllocator& other) const noexcept {
+		return m_resource != other.m_resource;
+	}
+
+private:
+	static size_t block_size(size_t n) noexcept {
+		return ((n * sizeof(T) + 63) / 64) * 64;
+	}
+
+	LimbResource* m_resource;
+};
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief primitive operations on raw little endian limb spans shared by the UnsignedBigInt
+/// kernels. unless stated otherwise an output may coincide with an input but must not partially
+/// overlap one.
+namespace limbs {
+
+typedef uint64_t limb_t;
+
+// ============================================================================
+// Section: carry chain kernels
+// ============================================================================
+// the loops every addition and multiplication bottoms out in. these portable versions are the
+// fallback, lib/limbs.cpp switches the table below to MULX/ADCX/ADOX assembly at startup on
+// cpus with BMI2 and ADX
+namespace portable {
+
+/// @brief out[0..n] = a + b, returns the carry
+inline limb_t add_n(limb_t* out, const limb_t* a, const limb_t* b, size_t n) {
+	__uint128_t carry = 0;
+	for(size_t i = 0; i < n; i++) {
+		const __uint128_t sum = static_cast<__uint128_t>(a[i]) + b[i] + carry;
+		out[i] = static_cast<limb_t>(sum);
+		carry = sum >> 64;
+	}
+	return static_cast<limb_t>(carry);
+}
+
+/// @brief out[0..n] = a - b, returns the borrow
+inline limb_t sub_n(limb_t* out, const limb_t* a, const limb_t* b, size_t n) {
+	// the borrow is read off the wrapped top half, keeping the chain free of branches
+	limb_t borrow = 0;
+	for(size_t i = 0; i < n; i++) {
+		const __uint128_t diff = static_cast<__uint128_t>(a[i]) - b[i] - borrow;
+		out[i] = static_cast<limb_t>(diff);
+		borrow = static_cast<limb_t>(diff >> 64) & 1;
+	}
+	return borrow;
+}
+
+/// @brief out[0..n] = a * b, returns the carry limb
+inline limb_t mul_1(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	__uint128_t carry = 0;
+	for(size_t i = 0; i < n; i++) {
+		const __uint128_t product = static_cast<__uint128_t>(a[i]) * b + carry;
+		out[i] = static_cast<limb_t>(product);
+		carry = product >> 64;
+	}
+	return static_cast<limb_t>(carry);
+}
+
+/// @brief out[0..n] += a * b, returns the carry limb
+inline limb_t addmul_1(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	__uint128_t carry = 0;
+	for(size_t i = 0; i < n; i++) {
+		const __uint128_t product = static_cast<__uint128_t>(a[i]) * b + out[i] + carry;
+		out[i] = static_cast<limb_t>(product);
+		carry = product >> 64;
+	}
+	return static_cast<limb_t>(carry);
+}
+
+/// @brief out[0..n] -= a * b, returns the borrow limb
+inline limb_t submul_1(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	limb_t borrow = 0;
+	for(size_t i = 0; i < n; i++) {
+		const __uint128_t product = static_cast<__uint128_t>(a[i]) * b + borrow;
+		const limb_t low = static_cast<limb_t>(product);
+		borrow = static_cast<limb_t>(product >> 64) + (out[i] < low);
+		out[i] -= low;
+	}
+	return borrow;
+}
+
+} // namespace portable
+
+/// @brief the kernels in use, one implementation per cpu for the whole process
+struct Kernels {
+	limb_t (*add_n)(limb_t* out, const limb_t* a, const limb_t* b, size_t n);
+	limb_t (*sub_n)(limb_t* out, const limb_t* a, const limb_t* b, size_t n);
+	limb_t (*mul_1)(limb_t* out, const limb_t* a, size_t n, limb_t b);
+	limb_t (*addmul_1)(limb_t* out, const limb_t* a, size_t n, limb_t b);
+	limb_t (*submul_1)(limb_t* out, const limb_t* a, size_t n, limb_t b);
+	const char* name;
+};
+
+/// @brief starts out portable, so it is usable during static initialization, and is switched
+/// to the best kernels for the cpu before main
+extern Kernels kernels;
+
+/// @brief out[0..n] = a + b, returns the carry
+inline limb_t add_n(limb_t* out, const limb_t* a, const limb_t* b, size_t n) {
+	return kernels.add_n(out, a, b, n);
+}
+
+/// @brief out[0..n] = a - b, returns the borrow
+inline limb_t sub_n(limb_t* out, const limb_t* a, const limb_t* b, size_t n) {
+	return kernels.sub_n(out, a, b, n);
+}
+
+/// @brief out[0..n] = a * b, returns the carry limb
+inline limb_t mul_1(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	return kernels.mul_1(out, a, n, b);
+}
+
+/// @brief out[0..n] += a * b, returns the carry limb
+inline limb_t addmul_1(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	return kernels.addmul_1(out, a, n, b);
+}
+
+/// @brief out[0..n] -= a * b, returns the borrow limb
+inline limb_t submul_1(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	return kernels.submul_1(out, a, n, b);
+}
+
+// ============================================================================
+// Section: spans
+// ============================================================================
+
+/// @brief out[0..an] = a + b, requires an >= bn
+/// @return carry out of the most significant limb
+inline limb_t add(limb_t* out, const limb_t* a, size_t an, const limb_t* b, size_t bn) {
+	assert(an >= bn);
+
+	limb_t carry = add_n(out, a, b, bn);
+	size_t i = bn;
+	for(; carry && i < an; i++) {
+		out[i] = a[i] + 1;
+		carry = out[i] == 0;
+	}
+	// in place the rest of a is already there
+	if(out != a) {
+		std::copy(a + i, a + an, out + i);
+	}
+	return carry;
+}
+
+/// @brief out[0..an] = a - b, requires an >= bn
+/// @return borrow out of the most significant limb
+inline limb_t sub(limb_t* out, const limb_t* a, size_t an, const limb_t* b, size_t bn) {
+	assert(an >= bn);
+
+	limb_t borrow = sub_n(out, a, b, bn);
+	size_t i = bn;
+	for(; borrow && i < an; i++) {
+		borrow = a[i] == 0;
+		out[i] = a[i] - 1;
+	}
+	if(out != a) {
+		std::copy(a + i, a + an, out + i);
+	}
+	return borrow;
+}
+
+/// @brief out[0..n] = a - b for a single limb b
+/// @return borrow out of the most significant limb
+inline limb_t sub_1(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	limb_t borrow = b;
+	for(size_t i = 0; i < n; i++) {
+		const limb_t lhs = a[i];
+		out[i] = lhs - borrow;
+		borrow = lhs < borrow;
+	}
+	return borrow;
+}
+
+/// @brief q[0..n] = a / d for a single limb divisor d != 0, q may equal a
+/// @return the remainder
+inline limb_t divrem_1(limb_t* q, const limb_t* a, size_t n, limb_t d) {
+	assert(d != 0);
+	limb_t rem = 0;
+	for(size_t i = n; i > 0; i--) {
+		const __uint128_t numerator = (static_cast<__uint128_t>(rem) << 64) | a[i - 1];
+		q[i - 1] = static_cast<limb_t>(numerator / d);
+		rem = static_cast<limb_t>(numerator % d);
+	}
+	return rem;
+}
+
+/// @brief three way compare of a and b, each possibly carrying leading zero limbs
+inline int compare(const limb_t* a, size_t an, const limb_t* b, size_t bn) {
+	while(an > bn) {
+		if(a[--an] != 0) {
+			return 1;
+		}
+	}
+	while(bn > an) {
+		if(b[--bn] != 0) {
+			return -1;
+		}
+	}
+	for(size_t i = an; i > 0; i--) {
+		if(a[i - 1] != b[i - 1]) {
+			return a[i - 1] < b[i - 1] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+/// @brief out[0..n] = |a - b| where a is n limbs and b is m <= n limbs
+/// @return true if a < b
+inline bool abs_diff(limb_t* out, const limb_t* a, size_t n, const limb_t* b, size_t m) {
+	if(compare(a, n, b, m) >= 0) {
+		limb_t borrow = 0;
+		for(size_t i = 0; i < n; i++) {
+			const limb_t rhs = i < m ? b[i] : 0;
+			const limb_t diff = a[i] - rhs - borrow;
+			borrow = (a[i] < rhs) || (a[i] - rhs < borrow);
+			out[i] = diff;
+		}
+		return false;
+	}
+
+	// b > a, so the limbs of a above m are zero
+	limb_t borrow = 0;
+	for(size_t i = 0; i < m; i++) {
+		const limb_t diff = b[i] - a[i] - borrow;
+		borrow = (b[i] < a[i]) || (b[i] - a[i] < borrow);
+		out[i] = diff;
+	}
+	std::fill(out + m, out + n, 0);
+	return true;
+}
+
+/// @brief out[0..n] = B^n - a mod B^n, the two's complement of a
+/// @return true if a is nonzero
+inline bool neg(limb_t* out, const limb_t* a, size_t n) {
+	size_t i = 0;
+	for(; i < n && a[i] == 0; i++) {
+		out[i] = 0;
+	}
+	if(i == n) {
+		return false;
+	}
+
+	out[i] = -a[i];
+	for(i++; i < n; i++) {
+		out[i] = ~a[i];
+	}
+	return true;
+}
+
+/// @brief out[0..n] = in << shift for 0 < shift < 64, returns the bits shifted out.
+/// out may equal in
+inline limb_t lshift(limb_t* out, const limb_t* in, size_t n, unsigned shift) {
+	const limb_t spill = in[n - 1] >> (64 - shift);
+	for(size_t i = n - 1; i > 0; i--) {
+		out[i] = (in[i] << shift) | (in[i - 1] >> (64 - shift));
+	}
+	out[0] = in[0] << shift;
+	return spill;
+}
+
+/// @brief out[0..n] = in >> shift for 0 < shift < 64, returns the bits shifted out in the
+/// high end of a limb. out may equal in
+inline limb_t rshift(limb_t* out, const limb_t* in, size_t n, unsigned shift) {
+	const limb_t spill = in[0] << (64 - shift);
+	for(size_t i = 0; i + 1 < n; i++) {
+		out[i] = (in[i] >> shift) | (in[i + 1] << (64 - shift));
+	}
+	out[n - 1] = in[n - 1] >> shift;
+	return spill;
+}
+
+} // namespace limbs
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "bignum.hpp"
+#include "ifma.hpp"
+
+#include <exception>
+
+/// @brief arithmetic modulo a fixed odd modulus N in montgomery form x * R mod N, where
+/// R = 2^(64n) and n is the limb count of N. products are reduced with limb shifts instead of
+/// divisions, which pays off once many operations share one modulus
+class MontgomeryContext {
+public:
+	/// @throws BigNumEvenModulusException if modulus is even or zero
+	explicit MontgomeryContext(const UnsignedBigInt& modulus);
+
+	/// @brief x * R mod N for any x
+	UnsignedBigInt to_mont(const UnsignedBigInt& x) const;
+
+	/// @brief x / R mod N, maps a montgomery form value below N back to its plain value
+	UnsignedBigInt from_mont(const UnsignedBigInt& x) const;
+
+	/// @brief a * b / R mod N for montgomery form values below N
+	UnsignedBigInt mul(const UnsignedBigInt& a, const UnsignedBigInt& b) const;
+
+	/// @brief a * a / R mod N for a montgomery form value below N
+	UnsignedBigInt sqr(const UnsignedBigInt& a) const;
+
+	/// @brief base^exp mod N on plain values, staying in montgomery form throughout
+	UnsignedBigInt pow(const UnsignedBigInt& base, const UnsignedBigInt& exp) const;
+
+	const UnsignedBigInt& modulus() const noexcept;
+
+private:
+	typedef UnsignedBigInt::base_t base_t;
+	typedef UnsignedBigInt::container container;
+
+	// moduli from this many limbs exponentiate in radix 2^52 on cpus with AVX-512 IFMA,
+	// measured with benchmarks/bench_modexp.cpp
+	inline static constexpr size_t IFMA_THRESHOLD = 8;
+
+	/// @brief out[0..n] = a * b / R mod N by coarsely integrated operand scanning
+	/// @param scratch at least 2 * n + 1 limbs
+	void mont_mul(base_t* out, const base_t* a, const base_t* b, base_t* scratch) const;
+
+	/// @brief out[0..n] = a * a / R mod N, squaring with the fast kernels before reducing
+	/// @param scratch at least scratch_size() limbs
+	void mont_sqr(base_t* out, const base_t* a, base_t* scratch) const;
+
+	/// @brief out[0..n] = x mod N, zero padded
+	void load(base_t* out, const UnsignedBigInt& x) const;
+
+	size_t scratch_size() const noexcept;
+
+	/// @brief pow on the IFMA kernels, requires m_ifma to be set up
+	UnsignedBigInt pow_ifma(const UnsignedBigInt& base, const UnsignedBigInt& exp) const;
+
+	UnsignedBigInt m_modulus;
+	size_t m_size;
+	base_t m_inverse; // -N^-1 mod 2^64
+	container m_r2; // R^2 mod N
+	ifma::Montgomery m_ifma; // empty unless the cpu runs IFMA and N is in its size range
+};
+
+class BigNumEvenModulusException : public std::exception {
+	const char* what() const noexcept override {
+		return "montgomery arithmetic needs an odd modulus";
+	}
+};
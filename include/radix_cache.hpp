@@ -0,0 +1,92 @@
+#pragma once
+
+#include "bignum.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+/// @brief process wide cache of the powers the divide and conquer radix conversions split at.
+/// a base b packs leaf_digits(b) digits into a limb, and level k of its table holds
+/// b^(leaf_digits(b) * 2^k). levels are squared up from the one below on first use and shared
+/// by every thread
+namespace radix_cache {
+
+inline constexpr unsigned MAX_BASE = 36;
+
+/// @brief digits of base that fit into a limb, the largest m with base^m < 2^64
+/// @param base in 2..36
+constexpr unsigned leaf_digits(unsigned base) noexcept {
+	assert(base >= 2 && base <= MAX_BASE);
+	unsigned ret = 0;
+	for(__uint128_t power = base; power >> 64 == 0; power *= base) {
+		ret++;
+	}
+	return ret;
+}
+
+/// @brief base^leaf_digits(base)
+constexpr uint64_t leaf_base(unsigned base) noexcept {
+	uint64_t ret = 1;
+	for(unsigned i = leaf_digits(base); i > 0; i--) {
+		ret *= base;
+	}
+	return ret;
+}
+
+/// @brief levels a conversion of digits digits splits at, those with leaf_digits * 2^k below
+/// digits
+size_t levels(unsigned base, size_t digits) noexcept;
+
+/// @brief the first levels of one base. they stay valid for the lifetime of the object, also
+/// across clear(), and are read only so any number of threads may share them
+class Powers {
+public:
+	Powers() = default;
+	// the levels may point into m_local, which a copy would not carry over
+	Powers(const Powers&) = delete;
+	Powers& operator=(const Powers&) = delete;
+	Powers(Powers&&) = default;
+	Powers& operator=(Powers&&) = default;
+
+	size_t size() const noexcept {
+		return m_levels.size();
+	}
+
+	const UnsignedBigInt& operator[](size_t k) const noexcept {
+		return *m_levels[k];
+	}
+
+private:
+	friend Powers get(unsigned base, size_t digits);
+
+	std::shared_ptr<const void> m_table; // keeps the cached levels alive
+	std::deque<UnsignedBigInt> m_local; // levels past the memory limit, computed for this object
+	std::vector<const UnsignedBigInt*> m_levels;
+};
+
+/// @brief the levels of base a conversion of digits digits needs, extending the cache first.
+/// levels that would take the cache past its memory limit are computed for the returned object
+/// only
+/// @param base in 2..36
+Powers get(unsigned base, size_t digits);
+
+/// @brief computes the levels for conversions of up to digits digits ahead of time
+void reserve(unsigned base, size_t digits);
+
+/// @brief drops every cached level. conversions running meanwhile keep the levels they hold
+void clear() noexcept;
+
+/// @brief bytes of limbs the cache may hold, 64 MiB unless set. lowering it does not drop
+/// levels already cached
+void set_memory_limit(size_t bytes) noexcept;
+
+size_t memory_limit() noexcept;
+
+/// @brief bytes of limbs held by cached levels
+size_t memory_usage() noexcept;
+
+} // namespace radix_cache
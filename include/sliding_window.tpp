@@ -0,0 +1,105 @@
+#pragma once
+
+#include "workspace.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/// @brief left to right sliding window exponentiation, shared by the modular exponentiation
+/// paths. the arithmetic is supplied by the caller so the same driver serves montgomery and
+/// barrett representations
+namespace sliding_window {
+
+/// @brief window width for an exponent of the given bit length, trading the 2^(w-1) odd powers
+/// in the table against roughly one multiplication per w + 1 exponent bits
+inline size_t window_size(size_t bits) noexcept {
+	if(bits > 671) {
+		return 6;
+	} else if(bits > 239) {
+		return 5;
+	} else if(bits > 79) {
+		return 4;
+	} else if(bits > 23) {
+		return 3;
+	}
+	return 1;
+}
+
+/// @brief out[0..n] = base^exp for a nonzero exponent on n limb values. the table of odd powers
+/// and the running result live in the current workspace
+/// @param mul callable (uint64_t* out, const uint64_t* a, const uint64_t* b), out never aliases
+/// an input
+/// @param sqr callable (uint64_t* out, const uint64_t* a), out never aliases a
+template <typename Exponent, typename Mul, typename Sqr>
+void pow(uint64_t* out, const uint64_t* base, size_t n, const Exponent& exp, Mul mul, Sqr sqr) {
+	const size_t bits = exp.most_significant_bit();
+	const size_t window = window_size(bits);
+	const size_t entries = size_t(1) << (window - 1);
+
+	// odd powers base^1, base^3, ..., base^(2^window - 1)
+	Workspace::Frame frame(current_workspace());
+	uint64_t* table = frame.take(entries * n);
+	std::copy(base, base + n, table);
+	if(window > 1) {
+		uint64_t* base_squared = frame.take(n);
+		sqr(base_squared, base);
+		for(size_t i = 1; i < entries; i++) {
+			mul(table + i * n, table + (i - 1) * n, base_squared);
+		}
+	}
+
+	// the window ending at bit top - 1 spans at most `window` bits and ends on a set bit, so
+	// its value is odd and indexes the table
+	auto read_window = [&](size_t top, size_t& len) {
+		len = std::min(window, top);
+		while(!exp.get_bit(top - len)) {
+			len--;
+		}
+		size_t value = 0;
+		for(size_t i = top; i > top - len; i--) {
+			value = (value << 1) | exp.get_bit(i - 1);
+		}
+		return value >> 1;
+	};
+
+	// every step writes the other of two buffers, starting from out
+	uint64_t* result = out;
+	uint64_t* spare = frame.take(n);
+	auto square = [&]() {
+		sqr(spare, result);
+		std::swap(result, spare);
+	};
+	auto multiply = [&](const uint64_t* factor) {
+		mul(spare, result, factor);
+		std::swap(result, spare);
+	};
+
+	size_t len;
+	size_t top = bits;
+	const uint64_t* first = table + read_window(top, len) * n;
+	std::copy(first, first + n, result);
+	top -= len;
+
+	while(top > 0) {
+		if(!exp.get_bit(top - 1)) {
+			square();
+			top--;
+			continue;
+		}
+
+		const size_t index = read_window(top, len);
+		for(size_t i = 0; i < len; i++) {
+			square();
+		}
+		multiply(table + index * n);
+		top -= len;
+	}
+
+	if(result != out) {
+		std::copy(result, result + n, out);
+	}
+}
+
+} // namespace sliding_window
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "aligned_alloc.tpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+/// @brief vector of trivially copyable values that keeps up to N of them inline and only moves
+/// to allocator storage once it grows past that
+/// @tparam T element type
+/// @tparam N number of elements stored without allocating
+/// @tparam Allocator may be stateful. copies take a default constructed allocator and moves
+/// between unequal allocators copy the elements, like std::pmr containers
+template <typename T, size_t N, typename Allocator = AlignedAllocator<T>>
+class SmallVector {
+	static_assert(std::is_trivially_copyable_v<T>, "elements are copied with std::copy");
+	static_assert(N > 0, "inline capacity must hold at least one element");
+
+public:
+	SmallVector() noexcept
+		: m_data(m_inline)
+		, m_size(0)
+		, m_capacity(N) { }
+
+	/// @brief n value initialized elements
+	explicit SmallVector(size_t n)
+		: SmallVector(n, T()) { }
+
+	SmallVector(size_t n, const T& value)
+		: SmallVector() {
+		resize(n, value);
+	}
+
+	SmallVector(const SmallVector& other)
+		: SmallVector() {
+		assign(other.begin(), other.end());
+	}
+
+	/// @brief steals heap storage along with its allocator, inline elements are copied and left
+	/// in place
+	SmallVector(SmallVector&& other) noexcept
+		: SmallVector() {
+		m_allocator = other.m_allocator;
+		steal(other);
+	}
+
+	SmallVector& operator=(const SmallVector& other) {
+		if(this != &other) {
+			assign(other.begin(), other.end());
+		}
+		return *this;
+	}
+
+	/// @brief steals other's storage if both share an allocator, otherwise copies
+	SmallVector& operator=(SmallVector&& other) {
+		if(this == &other) {
+			return *this;
+		}
+		if(m_allocator != other.m_allocator && !other.is_inline()) {
+			assign(other.begin(), other.end());
+			return *this;
+		}
+		release();
+		steal(other);
+		return *this;
+	}
+
+	~SmallVector() {
+		release();
+	}
+
+	T* data() noexcept {
+		return m_data;
+	}
+	const T* data() const noexcept {
+		return m_data;
+	}
+
+	T* begin() noexcept {
+		return m_data;
+	}
+	const T* begin() const noexcept {
+		return m_data;
+	}
+	T* end() noexcept {
+		return m_data + m_size;
+	}
+	const T* end() const noexcept {
+		return m_data + m_size;
+	}
+
+	T& operator[](size_t idx) noexcept {
+		assert(idx < m_size);
+		return m_data[idx];
+	}
+	const T& operator[](size_t idx) const noexcept {
+		assert(idx < m_size);
+		return m_data[idx];
+	}
+
+	T& back() noexcept {
+		assert(m_size > 0);
+		return m_data[m_size - 1];
+	}
+	const T& back() const noexcept {
+		assert(m_size > 0);
+		return m_data[m_size - 1];
+	}
+
+	size_t size() const noexcept {
+		return m_size;
+	}
+	size_t capacity() const noexcept {
+		return m_capacity;
+	}
+	bool empty() const noexcept {
+		return m_size == 0;
+	}
+	bool is_inline() const noexcept {
+		return m_data == m_inline;
+	}
+
+	/// @brief grows the capacity to at least n, keeping the elements
+	void reserve(size_t n) {
+		if(n <= m_capacity) {
+			return;
+		}
+
+		T* grown = m_allocator.allocate(n);
+		std::copy(m_data, m_data + m_size, grown);
+		release();
+		m_data = grown;
+		m_capacity = n;
+	}
+
+	void resize(size_t n) {
+		resize(n, T());
+	}
+
+	/// @brief new elements past the old size are set to value
+	void resize(size_t n, const T& value) {
+		reserve(n);
+		if(n > m_size) {
+			std::fill(m_data + m_size, m_data + n, value);
+		}
+		m_size = n;
+	}
+
+	void push_back(const T& value) {
+		if(m_size == m_capacity) {
+			// the value may live in this vector, so read it before the storage moves
+			const T copy = value;
+			reserve(2 * m_capacity);
+			m_data[m_size++] = copy;
+			return;
+		}
+		m_data[m_size++] = value;
+	}
+
+	void clear() noexcept {
+		m_size = 0;
+	}
+
+	/// @brief replaces the contents with [first, last), which must not point into this vector
+	template <typename It>
+	void assign(It first, It last) {
+		const size_t n = static_cast<size_t>(std::distance(first, last));
+		if(n > m_capacity) {
+			// allocate first, a throwing allocator leaves the old elements in place
+			T* grown = m_allocator.allocate(n);
+			release();
+			m_data = grown;
+			m_capacity = n;
+		}
+		std::copy(first, last, m_data);
+		m_size = n;
+	}
+
+private:
+	/// @brief frees heap storage and falls back to the inline buffer, the size is left as is
+	void release() noexcept {
+		if(!is_inline()) {
+			m_allocator.deallocate(m_data, m_capacity);
+			m_data = m_inline;
+			m_capacity = N;
+		}
+	}
+
+	/// @brief takes over other's elements, other keeps its inline ones or ends up empty
+	void steal(SmallVector& other) noexcept {
+		if(other.is_inline()) {
+			std::copy(other.m_inline, other.m_inline + other.m_size, m_inline);
+			m_size = other.m_size;
+			return;
+		}
+
+		m_data = other.m_data;
+		m_size = other.m_size;
+		m_capacity = other.m_capacity;
+		other.m_data = other.m_inline;
+		other.m_size = 0;
+		other.m_capacity = N;
+	}
+
+	T* m_data;
+	size_t m_size;
+	size_t m_capacity;
+	[[no_unique_address]] Allocator m_allocator;
+	T m_inline[N];
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Section: thread pool
+// ============================================================================
+
+/// @brief work stealing pool for fork join parallelism. every worker owns a deque it pushes its
+/// own tasks to and pops them from in last in first out order, so a recursion runs depth first
+/// on each thread. idle workers steal the oldest task of another deque, which is the largest
+/// subproblem still waiting. tasks queued from threads outside the pool go to a shared deque
+class ThreadPool {
+public:
+	/// @brief a set of tasks forked together and joined by wait()
+	class TaskGroup {
+	public:
+		explicit TaskGroup(ThreadPool& pool) noexcept;
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		/// @brief waits for the tasks still running, dropping their exceptions
+		~TaskGroup();
+
+		/// @brief queues a task. it inherits the ParallelScope of the calling thread
+		void run(std::function<void()> task);
+
+		/// @brief runs queued tasks, the group's own and stolen ones, until every task of the
+		/// group has finished. rethrows the first exception a task threw
+		void wait();
+
+	private:
+		friend class ThreadPool;
+
+		void finish(std::exception_ptr error) noexcept;
+		void join() noexcept;
+
+		ThreadPool& m_pool;
+		std::atomic<size_t> m_pending { 0 };
+		std::mutex m_error_mutex;
+		std::exception_ptr m_error;
+	};
+
+	/// @brief a pool running tasks on threads threads, the calling thread of a wait() being one
+	/// of them. 0 picks std::thread::hardware_concurrency()
+	explicit ThreadPool(size_t threads = 0);
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// @brief joins the workers, requires every task group to have finished
+	~ThreadPool();
+
+	/// @brief threads working on tasks, counting the one waiting on a group
+	size_t threads() const noexcept;
+
+private:
+	struct Task {
+		std::function<void()> run;
+		TaskGroup* group;
+	};
+
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	/// @brief deque the calling thread pushes to, the shared one outside the pool's workers
+	size_t own_queue() const noexcept;
+	void push(Task task);
+
+	/// @brief takes the newest task of the calling thread's deque, or steals the oldest of
+	/// another, and runs it
+	/// @return false if every deque was empty
+	bool run_one();
+
+	void work(size_t index);
+
+	/// @brief wakes the workers and joins them once they are out of tasks
+	void stop() noexcept;
+
+	std::vector<std::unique_ptr<Queue>> m_queues; // one per worker, the shared one last
+	std::vector<std::thread> m_workers;
+	std::atomic<size_t> m_queued { 0 };
+	std::mutex m_sleep_mutex;
+	std::condition_variable m_wake;
+	bool m_stop = false;
+};
+
+// ============================================================================
+// Section: parallel scope
+// ============================================================================
+
+/// @brief runs the large multiplications of the calling thread on a pool while in scope. the
+/// recursive algorithms fork the subproducts of operands of at least grain limbs, and the
+/// number theoretic transforms split their stages into tasks of at least grain points, smaller
+/// work stays on the thread reaching it. scopes nest like WorkspaceScope, and tasks run in the
+/// scope they were queued from
+class ParallelScope {
+public:
+	// below this many limbs the subproducts are too short to pay for handing them over
+	inline static constexpr size_t DEFAULT_GRAIN = 1024;
+
+	explicit ParallelScope(ThreadPool& pool, size_t grain = DEFAULT_GRAIN) noexcept;
+	ParallelScope(const ParallelScope&) = delete;
+	ParallelScope& operator=(const ParallelScope&) = delete;
+	~ParallelScope();
+
+private:
+	ThreadPool* m_previous_pool;
+	size_t m_previous_grain;
+};
+
+/// @brief pool of the innermost ParallelScope of the calling thread, null outside of one
+ThreadPool* current_pool() noexcept;
+
+/// @brief grain of the innermost ParallelScope of the calling thread
+size_t current_grain() noexcept;
+
+/// @brief whether work of size limbs or points is split into tasks on the current pool
+inline bool should_fork(size_t size) noexcept {
+	return current_pool() != nullptr && size >= current_grain();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// Section: workspace
+// ============================================================================
+
+/// @brief stack of scratch limbs the kernels take their temporaries from. limbs are taken
+/// through frames and handed back in last in first out order when a frame ends. the workspace
+/// remembers the most limbs ever live at once, so a caller can run a computation once, read
+/// peak() and from then on serve the same computation from a workspace of that capacity without
+/// touching the heap
+class Workspace {
+public:
+	// limbs in the first chunk a workspace grows by, later chunks double the capacity
+	inline static constexpr size_t MIN_CHUNK = 512;
+
+	/// @brief scratch taken from a workspace for the lifetime of the frame. frames on the same
+	/// workspace must end in the reverse order they were opened
+	class Frame {
+	public:
+		explicit Frame(Workspace& workspace) noexcept;
+		Frame(const Frame&) = delete;
+		Frame& operator=(const Frame&) = delete;
+		~Frame();
+
+		/// @brief n uninitialized limbs, 64 byte aligned and valid until the frame ends. takes
+		/// are rounded up to whole cache lines
+		uint64_t* take(size_t n);
+
+	private:
+		Workspace& m_workspace;
+		size_t m_chunk;
+		size_t m_offset;
+		size_t m_used;
+	};
+
+	Workspace() = default;
+
+	/// @brief starts out with room for limbs scratch limbs
+	explicit Workspace(size_t limbs);
+
+	Workspace(const Workspace&) = delete;
+	Workspace& operator=(const Workspace&) = delete;
+	~Workspace();
+
+	/// @brief limbs held by open frames
+	size_t used() const noexcept;
+
+	/// @brief most limbs held by open frames at any one time
+	size_t peak() const noexcept;
+
+	void reset_peak() noexcept;
+
+	/// @brief limbs the workspace can hand out without allocating
+	size_t capacity() const noexcept;
+
+	/// @brief grows the capacity to at least limbs, requires no open frames
+	void reserve(size_t limbs);
+
+	/// @brief frees every chunk, requires no open frames
+	void release() noexcept;
+
+private:
+	struct Chunk {
+		uint64_t* data;
+		size_t size;
+	};
+
+	uint64_t* take(size_t n);
+	void add_chunk(size_t limbs);
+
+	std::vector<Chunk> m_chunks;
+	size_t m_chunk = 0; // chunk the next limbs come from
+	size_t m_offset = 0; // limbs taken from that chunk
+	size_t m_used = 0;
+	size_t m_peak = 0;
+	size_t m_capacity = 0;
+};
+
+/// @brief routes the calling thread's kernels to a workspace while in scope. scopes nest like
+/// ArenaScope
+class WorkspaceScope {
+public:
+	explicit WorkspaceScope(Workspace& workspace) noexcept;
+	WorkspaceScope(const WorkspaceScope&) = delete;
+	WorkspaceScope& operator=(const WorkspaceScope&) = delete;
+	~WorkspaceScope();
+
+private:
+	Workspace* m_previous;
+};
+
+/// @brief workspace the calling thread's kernels take scratch from, a thread local one unless a
+/// WorkspaceScope is active
+Workspace& current_workspace() noexcept;
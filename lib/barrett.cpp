@@ -0,0 +1,197 @@
+#include "include/barrett.hpp"
+#include "include/limbs.hpp"
+#include "include/sliding_window.tpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace limbs;
+
+// ============================================================================
+// Section: truncated products
+// ============================================================================
+// barrett only needs the top of the quotient estimate and the bottom of its product with the
+// modulus, so below the multiplication thresholds half of each schoolbook product is skipped
+namespace {
+
+/// @brief out[0..an+bn] = a * b without the partial products below column from, which leaves
+/// the result short of the full product by less than an * B^from
+void mul_high(limb_t* out, const limb_t* a, size_t an, const limb_t* b, size_t bn, size_t from) {
+	std::fill(out, out + an + bn, 0);
+	for(size_t i = 0; i < an; i++) {
+		const size_t j = from > i ? std::min(from - i, bn) : 0;
+		out[i + bn] = addmul_1(out + i + j, b + j, bn - j, a[i]);
+	}
+}
+
+/// @brief r[0..n] -= a * b mod B^n, requires bn <= n
+void submul_low(limb_t* r, size_t n, const limb_t* a, size_t an, const limb_t* b, size_t bn) {
+	for(size_t i = 0; i < std::min(an, n); i++) {
+		const size_t len = std::min(bn, n - i);
+		const limb_t borrow = submul_1(r + i, b, len, a[i]);
+		sub_1(r + i + len, r + i + len, n - i - len, borrow);
+	}
+}
+
+} // namespace
+
+// ============================================================================
+// Section: setup
+// ============================================================================
+BarrettContext::BarrettContext(const UnsignedBigInt& modulus)
+	: m_modulus(modulus)
+	, m_size(modulus.m_digits) {
+	if(modulus == UnsignedBigInt(0)) {
+		throw BigNumDivideByZeroException();
+	}
+
+	const UnsignedBigInt mu = (UnsignedBigInt(1) << (128 * m_size)) / modulus;
+	m_mu.assign(mu.m_container.begin(), mu.m_container.begin() + mu.m_digits);
+}
+
+const UnsignedBigInt& BarrettContext::modulus() const noexcept {
+	return m_modulus;
+}
+
+void BarrettContext::load(base_t* out, const UnsignedBigInt& x) const {
+	if(x >= m_modulus) {
+		load(out, reduce(x));
+		return;
+	}
+	std::fill(std::copy(x.m_container.begin(), x.m_container.begin() + x.m_digits, out),
+			  out + m_size,
+			  0);
+}
+
+size_t BarrettContext::reduce_scratch_size() const noexcept {
+	const size_t k = m_size;
+	const size_t mn = m_mu.size();
+	return (k + 1 + mn) + (mn + k) + (k + 1) +
+		   std::max(UnsignedBigInt::mul_scratch_size(mn, k + 1),
+					UnsignedBigInt::mul_scratch_size(mn, k));
+}
+
+// ============================================================================
+// Section: limb kernels
+// ============================================================================
+void BarrettContext::reduce_limbs(base_t* out, const base_t* x, base_t* scratch) const {
+	const size_t k = m_size;
+	const size_t mn = m_mu.size();
+	const base_t* modulus = m_modulus.m_container.data();
+	base_t* q2 = scratch;
+	base_t* product = q2 + k + 1 + mn;
+	base_t* r = product + mn + k;
+	base_t* mul_scratch = r + k + 1;
+
+	// q3 = floor(floor(x / B^(k - 1)) * mu / B^(k + 1)) undershoots x / m by at most 2. only
+	// the low k + 1 limbs of x - q3 * m are needed since the remainder fits in them
+	if(k < TRUNCATED_THRESHOLD) {
+		// skipping the columns below k - 1 costs at most one more correction
+		mul_high(q2, x + k - 1, k + 1, m_mu.data(), mn, k - 1);
+		std::copy(x, x + k + 1, r);
+		submul_low(r, k + 1, q2 + k + 1, mn, modulus, k);
+	} else {
+		UnsignedBigInt::mul_limbs(q2, m_mu.data(), mn, x + k - 1, k + 1, mul_scratch);
+		UnsignedBigInt::mul_limbs(product, q2 + k + 1, mn, modulus, k, mul_scratch);
+		sub(r, x, k + 1, product, k + 1);
+	}
+
+	// at most two rounds, three after the truncated product
+	while(compare(r, k + 1, modulus, k) >= 0) {
+		sub(r, r, k + 1, modulus, k);
+	}
+	std::copy(r, r + k, out);
+}
+
+// ============================================================================
+// Section: arithmetic
+// ============================================================================
+UnsignedBigInt BarrettContext::reduce(const UnsignedBigInt& x) const {
+	if(x < m_modulus) {
+		return x;
+	}
+	if(x.m_digits > 2 * m_size) {
+		return x % m_modulus;
+	}
+
+	Workspace::Frame frame(current_workspace());
+	base_t* padded = frame.take(2 * m_size);
+	std::fill(std::copy(x.m_container.begin(), x.m_container.begin() + x.m_digits, padded),
+			  padded + 2 * m_size,
+			  0);
+
+	UnsignedBigInt ret;
+	ret.m_container.resize(m_size);
+	reduce_limbs(ret.m_container.data(), padded, frame.take(reduce_scratch_size()));
+	ret.m_digits = m_size;
+	ret.normalize();
+	return ret;
+}
+
+void BarrettContext::reduce_batch(std::vector<UnsignedBigInt>& values) const {
+	Workspace::Frame frame(current_workspace());
+	base_t* padded = frame.take(2 * m_size);
+	base_t* scratch = frame.take(reduce_scratch_size());
+
+	for(UnsignedBigInt& x : values) {
+		if(x < m_modulus) {
+			continue;
+		}
+		if(x.m_digits > 2 * m_size) {
+			x %= m_modulus;
+			continue;
+		}
+
+		std::fill(std::copy(x.m_container.begin(), x.m_container.begin() + x.m_digits, padded),
+				  padded + 2 * m_size,
+				  0);
+		reduce_limbs(x.m_container.data(), padded, scratch);
+		x.m_digits = m_size;
+		x.normalize();
+	}
+}
+
+UnsignedBigInt BarrettContext::mul(const UnsignedBigInt& a, const UnsignedBigInt& b) const {
+	return reduce(a * b);
+}
+
+UnsignedBigInt BarrettContext::sqr(const UnsignedBigInt& a) const {
+	return reduce(a.square());
+}
+
+UnsignedBigInt BarrettContext::pow(const UnsignedBigInt& base, const UnsignedBigInt& exp) const {
+	if(exp == UnsignedBigInt(0)) {
+		return reduce(UnsignedBigInt(1));
+	}
+
+	// the exponentiation runs on workspace limbs, products and kernel scratch are shared by
+	// every step
+	const size_t k = m_size;
+	Workspace::Frame frame(current_workspace());
+	base_t* product = frame.take(2 * k);
+	base_t* kernel_scratch =
+		frame.take(std::max(UnsignedBigInt::mul_n_scratch_size(k), reduce_scratch_size()));
+	base_t* x = frame.take(k);
+	load(x, base);
+
+	UnsignedBigInt ret;
+	ret.m_container.resize(k);
+	sliding_window::pow(
+		ret.m_container.data(),
+		x,
+		k,
+		exp,
+		[&](base_t* out, const base_t* a, const base_t* b) {
+			UnsignedBigInt::mul_n(product, a, b, k, kernel_scratch);
+			reduce_limbs(out, product, kernel_scratch);
+		},
+		[&](base_t* out, const base_t* a) {
+			UnsignedBigInt::sqr_n(product, a, k, kernel_scratch);
+			reduce_limbs(out, product, kernel_scratch);
+		});
+
+	ret.m_digits = k;
+	ret.normalize();
+	return ret;
+}
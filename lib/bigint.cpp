@@ -0,0 +1,241 @@
+#include "include/bigint.hpp"
+#include "include/limbs.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+// ============================================================================
+// Section: Constructors
+// ============================================================================
+BigInt::BigInt(int number) noexcept
+	: BigInt(static_cast<int64_t>(number)) { }
+
+BigInt::BigInt(int64_t number) noexcept
+	: m_magnitude(number < 0 ? 0 - static_cast<uint64_t>(number) : static_cast<uint64_t>(number))
+	, m_negative(number < 0) { }
+
+BigInt::BigInt(const UnsignedBigInt& magnitude, bool negative)
+	: m_magnitude(magnitude)
+	, m_negative(negative && !is_zero()) { }
+
+BigInt::BigInt(UnsignedBigInt&& magnitude, bool negative) noexcept
+	: m_magnitude(std::move(magnitude))
+	, m_negative(negative && !is_zero()) { }
+
+BigInt::BigInt(const std::string& number)
+	: m_negative(false) {
+	const bool has_sign = !number.empty() && (number[0] == '-' || number[0] == '+');
+	m_magnitude = UnsignedBigInt(has_sign ? number.substr(1) : number);
+	m_negative = has_sign && number[0] == '-' && !is_zero();
+}
+
+// ============================================================================
+// Section: algebraic operations
+// ============================================================================
+void BigInt::add_signed(const UnsignedBigInt& magnitude, bool negative) {
+	if(m_negative == negative) {
+		m_magnitude += magnitude;
+		return;
+	}
+
+	// opposite signs subtract the magnitudes. the longer one is known to be larger, for equal
+	// lengths the difference is taken as is and negated if it borrowed
+	UnsignedBigInt& a = m_magnitude;
+	const size_t an = a.m_digits;
+	const size_t bn = magnitude.m_digits;
+	if(an >= bn) {
+		limbs::limb_t* out = a.m_container.data();
+		if(limbs::sub(out, out, an, magnitude.m_container.data(), bn)) {
+			limbs::neg(out, out, an);
+			m_negative = !m_negative;
+		}
+	} else {
+		// magnitude is a different value here, so growing this one cannot invalidate it
+		if(a.m_container.size() < bn) {
+			a.m_container.resize(bn);
+		}
+		limbs::limb_t* out = a.m_container.data();
+		limbs::sub(out, magnitude.m_container.data(), bn, out, an);
+		a.m_digits = bn;
+		m_negative = negative;
+	}
+
+	a.normalize();
+	if(is_zero()) {
+		m_negative = false;
+	}
+}
+
+BigInt& BigInt::operator+=(const BigInt& other) {
+	add_signed(other.m_magnitude, other.m_negative);
+	return *this;
+}
+
+BigInt& BigInt::operator-=(const BigInt& other) {
+	add_signed(other.m_magnitude, !other.m_negative);
+	return *this;
+}
+
+BigInt& BigInt::operator*=(const BigInt& other) {
+	m_negative = m_negative != other.m_negative;
+	m_magnitude *= other.m_magnitude;
+	if(is_zero()) {
+		m_negative = false;
+	}
+	return *this;
+}
+
+BigInt& BigInt::operator/=(const BigInt& other) {
+	*this = divmod(other).first;
+	return *this;
+}
+
+BigInt& BigInt::operator%=(const BigInt& other) {
+	*this = divmod(other).second;
+	return *this;
+}
+
+std::pair<BigInt, BigInt> BigInt::divmod(const BigInt& divisor, DivisionMode mode) const {
+	auto [q, r] = m_magnitude.divmod(divisor.m_magnitude);
+	BigInt quotient(std::move(q), m_negative != divisor.m_negative);
+	BigInt remainder(std::move(r), m_negative);
+
+	// truncation rounded a negative quotient up, step it down and move the remainder over to
+	// the divisor's sign
+	if(mode == DivisionMode::FLOOR && !remainder.is_zero() &&
+	   m_negative != divisor.m_negative) {
+		quotient -= 1;
+		remainder += divisor;
+	}
+	return { std::move(quotient), std::move(remainder) };
+}
+
+BigInt& BigInt::negate() noexcept {
+	m_negative = !m_negative && !is_zero();
+	return *this;
+}
+
+BigInt BigInt::operator-() const& {
+	BigInt ret = *this;
+	ret.negate();
+	return ret;
+}
+
+BigInt BigInt::operator-() && {
+	negate();
+	return std::move(*this);
+}
+
+BigInt BigInt::operator+(const BigInt& other) const& {
+	BigInt ret = *this;
+	ret += other;
+	return ret;
+}
+
+BigInt BigInt::operator-(const BigInt& other) const& {
+	BigInt ret = *this;
+	ret -= other;
+	return ret;
+}
+
+BigInt BigInt::operator*(const BigInt& other) const& {
+	BigInt ret = *this;
+	ret *= other;
+	return ret;
+}
+
+BigInt BigInt::operator/(const BigInt& other) const& {
+	return divmod(other).first;
+}
+
+BigInt BigInt::operator%(const BigInt& other) const& {
+	return divmod(other).second;
+}
+
+BigInt BigInt::operator+(const BigInt& other) && {
+	*this += other;
+	return std::move(*this);
+}
+
+BigInt BigInt::operator-(const BigInt& other) && {
+	*this -= other;
+	return std::move(*this);
+}
+
+BigInt BigInt::operator*(const BigInt& other) && {
+	*this *= other;
+	return std::move(*this);
+}
+
+BigInt BigInt::operator/(const BigInt& other) && {
+	return divmod(other).first;
+}
+
+BigInt BigInt::operator%(const BigInt& other) && {
+	return divmod(other).second;
+}
+
+// ============================================================================
+// Section: Comparators
+// ============================================================================
+std::strong_ordering BigInt::operator<=>(const BigInt& other) const noexcept {
+	if(m_negative != other.m_negative) {
+		return m_negative ? std::strong_ordering::less : std::strong_ordering::greater;
+	}
+	// larger magnitudes are smaller below zero
+	return m_negative ? other.m_magnitude <=> m_magnitude : m_magnitude <=> other.m_magnitude;
+}
+
+bool BigInt::operator<(const BigInt& other) const {
+	return (*this <=> other) < 0;
+}
+
+bool BigInt::operator>(const BigInt& other) const {
+	return (*this <=> other) > 0;
+}
+
+bool BigInt::operator<=(const BigInt& other) const {
+	return (*this <=> other) <= 0;
+}
+
+bool BigInt::operator>=(const BigInt& other) const {
+	return (*this <=> other) >= 0;
+}
+
+bool BigInt::operator==(const BigInt& other) const {
+	return m_negative == other.m_negative && m_magnitude == other.m_magnitude;
+}
+
+bool BigInt::operator!=(const BigInt& other) const {
+	return !(*this == other);
+}
+
+// ============================================================================
+// Section: helpers
+// ============================================================================
+int BigInt::sign() const noexcept {
+	if(is_zero()) {
+		return 0;
+	}
+	return m_negative ? -1 : 1;
+}
+
+bool BigInt::is_negative() const noexcept {
+	return m_negative;
+}
+
+const UnsignedBigInt& BigInt::magnitude() const& noexcept {
+	return m_magnitude;
+}
+
+UnsignedBigInt BigInt::magnitude() && {
+	return std::move(m_magnitude);
+}
+
+bool BigInt::is_zero() const noexcept {
+	return m_magnitude.m_digits == 1 && m_magnitude.m_container[0] == 0;
+}
+
+std::string BigInt::to_string() const {
+	return m_negative ? "-" + m_magnitude.to_string() : m_magnitude.to_string();
+}
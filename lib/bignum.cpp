@@ -1,13 +1,15 @@
 #include "include/bignum.hpp"
+#include "include/barrett.hpp"
+#include "include/limbs.hpp"
+#include "include/montgomery.hpp"
+#include "include/workspace.hpp"
 
-#include <bitset>
+#include <algorithm>
 #include <cassert>
-#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <functional>
 #include <iostream>
-#include <sstream>
 #include <string>
 
 // ============================================================================
@@ -16,25 +18,15 @@
 UnsignedBigInt::UnsignedBigInt(const std::string& number)
 	: m_digits(1)
 	, m_container(UnsignedBigInt::INITIAL_ALLOCATIONS_SIZE, 0) {
-	static constexpr size_t LEN = 18;
-	static constexpr uint64_t BASE = 1000000000000000000ULL;
-
-	std::string_view slice{ number };
-
-	while(slice.length() >= LEN) {
-		std::string sliced_number{ slice.substr(0, LEN) };
-		slice.remove_prefix(LEN);
-		uint64_t num = std::strtoull(sliced_number.c_str(), nullptr, 10);
-		*this *= BASE;
-		*this += num;
-	}
+	parse(number, 10);
+}
 
-	if(slice.length()) {
-		uint64_t number = std::stoull(slice.data());
-		*this *= std::pow(10ull, slice.length());
-		*this += number;
-	}
+UnsignedBigInt::UnsignedBigInt(UnsignedBigInt&& bignum) noexcept
+	: m_digits(bignum.m_digits)
+	, m_container(std::move(bignum.m_container)) {
+	bignum.clear_moved_from();
 }
+
 // ============================================================================
 // Section: Assignment Operators
 // ============================================================================
@@ -66,6 +58,22 @@ UnsignedBigInt& UnsignedBigInt::operator=(const UnsignedBigInt& bignum) {
 	return *this;
 }
 
+UnsignedBigInt& UnsignedBigInt::operator=(UnsignedBigInt&& bignum) {
+	if(this != &bignum) {
+		m_container = std::move(bignum.m_container);
+		m_digits = bignum.m_digits;
+		bignum.clear_moved_from();
+	}
+	return *this;
+}
+
+void UnsignedBigInt::clear_moved_from() noexcept {
+	// the initial size fits the inline buffer, so this never allocates
+	m_container.resize(INITIAL_ALLOCATIONS_SIZE, 0);
+	m_container[0] = 0;
+	m_digits = 1;
+}
+
 // ============================================================================
 // Section: algebraic operations
 // ============================================================================
@@ -78,35 +86,60 @@ inline UnsignedBigInt apply_binary_op(const UnsignedBigInt& lhs,
 	return ret;
 }
 
-UnsignedBigInt UnsignedBigInt::operator+(const uint64_t& other) const {
+/// @brief same as above for an expiring lhs, whose storage becomes the result
+template <typename T>
+inline UnsignedBigInt apply_binary_op(UnsignedBigInt&& lhs,
+									  const T& rhs,
+									  UnsignedBigInt& (UnsignedBigInt::*op)(const T&)) {
+	(lhs.*op)(rhs);
+	return std::move(lhs);
+}
+
+UnsignedBigInt UnsignedBigInt::operator+(const uint64_t& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator+=);
 }
-UnsignedBigInt UnsignedBigInt::operator-(const uint64_t& other) const {
+UnsignedBigInt UnsignedBigInt::operator-(const uint64_t& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator-=);
 }
-UnsignedBigInt UnsignedBigInt::operator*(const uint64_t& other) const {
+UnsignedBigInt UnsignedBigInt::operator*(const uint64_t& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator*=);
 }
 // UnsignedBigInt UnsignedBigInt::operator/(const uint64_t& other) const {
 // 	return apply_binary_op(*this, other, &UnsignedBigInt::operator/=);
 // }
-UnsignedBigInt UnsignedBigInt::operator<<(const uint64_t& other) const {
+UnsignedBigInt UnsignedBigInt::operator<<(const uint64_t& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator<<=);
 }
-UnsignedBigInt UnsignedBigInt::operator>>(const uint64_t& other) const {
+UnsignedBigInt UnsignedBigInt::operator>>(const uint64_t& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator>>=);
 }
 
-UnsignedBigInt UnsignedBigInt::operator+(const UnsignedBigInt& other) const {
+UnsignedBigInt UnsignedBigInt::operator+(const uint64_t& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator+=);
+}
+UnsignedBigInt UnsignedBigInt::operator-(const uint64_t& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator-=);
+}
+UnsignedBigInt UnsignedBigInt::operator*(const uint64_t& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator*=);
+}
+UnsignedBigInt UnsignedBigInt::operator<<(const uint64_t& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator<<=);
+}
+UnsignedBigInt UnsignedBigInt::operator>>(const uint64_t& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator>>=);
+}
+
+UnsignedBigInt UnsignedBigInt::operator+(const UnsignedBigInt& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator+=);
 }
-UnsignedBigInt UnsignedBigInt::operator-(const UnsignedBigInt& other) const {
+UnsignedBigInt UnsignedBigInt::operator-(const UnsignedBigInt& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator-=);
 }
-UnsignedBigInt UnsignedBigInt::operator*(const UnsignedBigInt& other) const {
+UnsignedBigInt UnsignedBigInt::operator*(const UnsignedBigInt& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator*=);
 }
-UnsignedBigInt UnsignedBigInt::operator/(const UnsignedBigInt& other) const {
+UnsignedBigInt UnsignedBigInt::operator/(const UnsignedBigInt& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator/=);
 }
 // UnsignedBigInt UnsignedBigInt::operator<<(const UnsignedBigInt& other) const {
@@ -115,31 +148,72 @@ UnsignedBigInt UnsignedBigInt::operator/(const UnsignedBigInt& other) const {
 // UnsignedBigInt UnsignedBigInt::operator>>(const UnsignedBigInt& other) const {
 // 	return apply_binary_op(*this, other, &UnsignedBigInt::operator>>=);
 // }
-UnsignedBigInt UnsignedBigInt::operator^(const UnsignedBigInt& other) const {
+UnsignedBigInt UnsignedBigInt::operator^(const UnsignedBigInt& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator^=);
 }
-UnsignedBigInt UnsignedBigInt::operator%(const UnsignedBigInt& other) const {
+UnsignedBigInt UnsignedBigInt::operator%(const UnsignedBigInt& other) const& {
 	return apply_binary_op(*this, other, &UnsignedBigInt::operator%=);
 }
 UnsignedBigInt UnsignedBigInt::modulus_exp(const UnsignedBigInt& exp,
-										   const UnsignedBigInt& mod) const {
+										   const UnsignedBigInt& mod) const& {
 	UnsignedBigInt ret = *this;
 	ret.modulus_exp_eq(exp, mod);
 	return ret;
 }
+UnsignedBigInt UnsignedBigInt::square() const& {
+	UnsignedBigInt ret = *this;
+	ret.square_eq();
+	return ret;
+}
+
+UnsignedBigInt UnsignedBigInt::operator+(const UnsignedBigInt& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator+=);
+}
+UnsignedBigInt UnsignedBigInt::operator-(const UnsignedBigInt& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator-=);
+}
+UnsignedBigInt UnsignedBigInt::operator*(const UnsignedBigInt& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator*=);
+}
+UnsignedBigInt UnsignedBigInt::operator/(const UnsignedBigInt& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator/=);
+}
+UnsignedBigInt UnsignedBigInt::operator^(const UnsignedBigInt& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator^=);
+}
+UnsignedBigInt UnsignedBigInt::operator%(const UnsignedBigInt& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator%=);
+}
+UnsignedBigInt UnsignedBigInt::modulus_exp(const UnsignedBigInt& exp,
+										   const UnsignedBigInt& mod) && {
+	modulus_exp_eq(exp, mod);
+	return std::move(*this);
+}
+UnsignedBigInt UnsignedBigInt::square() && {
+	square_eq();
+	return std::move(*this);
+}
+
+UnsignedBigInt UnsignedBigInt::operator+(UnsignedBigInt&& other) const& {
+	return apply_binary_op(std::move(other), *this, &UnsignedBigInt::operator+=);
+}
+UnsignedBigInt UnsignedBigInt::operator*(UnsignedBigInt&& other) const& {
+	return apply_binary_op(std::move(other), *this, &UnsignedBigInt::operator*=);
+}
+UnsignedBigInt UnsignedBigInt::operator+(UnsignedBigInt&& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator+=);
+}
+UnsignedBigInt UnsignedBigInt::operator*(UnsignedBigInt&& other) && {
+	return apply_binary_op(std::move(*this), other, &UnsignedBigInt::operator*=);
+}
 
 // ============================================================================
 // Section: assignment algebraic operations for primitives
 // ============================================================================
 
 UnsignedBigInt& UnsignedBigInt::operator+=(const uint64_t& other) {
-	__uint128_t carry = static_cast<__uint128_t>(other);
-
-	for(size_t i = 0; i < m_digits; i++) {
-		__uint128_t sum = m_container[i] + carry;
-		m_container[i] = static_cast<uint64_t>(sum);
-		carry = sum >> 64;
-	}
+	base_t* data = m_container.data();
+	const base_t carry = limbs::add(data, data, m_digits, &other, 1);
 
 	if(carry) {
 		if(m_digits < m_container.size()) {
@@ -154,45 +228,36 @@ UnsignedBigInt& UnsignedBigInt::operator+=(const uint64_t& other) {
 }
 
 UnsignedBigInt& UnsignedBigInt::operator-=(const uint64_t& other) {
-	if(m_digits == 1 && m_container[0] < other) {
+	if(!try_sub(other)) {
 		throw BigNumUnderflowException(*this, other);
 	}
+	return *this;
+}
 
-	size_t i = 0;
-	uint64_t borrow = other;
-	for(; i < m_digits; i++) {
-		if(borrow == 0) {
-			break;
-		}
-
-		if(m_container[i] >= borrow) {
-			// fully absorb the borrow
-			m_container[i] -= borrow;
-			borrow = 0;
-		} else {
-			uint64_t new_value = (UnsignedBigInt::MAX_U64_VALUE - borrow) + m_container[i];
-			m_container[i] = new_value;
-			borrow = 1;
-		}
+bool UnsignedBigInt::try_sub(const uint64_t& other) noexcept {
+	if(m_digits == 1 && m_container[0] < other) {
+		return false;
 	}
 
-	if(i == m_digits && m_digits != 1 && m_container[i - 1] == 0) {
-		// if we borrowed from the highest digit,
-		// we need to check if we decreased the number of digits
-		// in the number
-		m_digits--;
+	// working in place, the walk ends as soon as the borrow is absorbed
+	base_t borrow = other;
+	for(size_t i = 0; borrow; i++) {
+		const base_t limb = m_container[i];
+		m_container[i] = limb - borrow;
+		borrow = limb < borrow;
 	}
-
-	return *this;
+	normalize();
+	return true;
 }
 
 UnsignedBigInt& UnsignedBigInt::operator*=(const uint64_t& other) {
-	__uint128_t carry = 0;
-	for(size_t i = 0; i < m_digits; i++) {
-		__uint128_t product = static_cast<__uint128_t>(m_container[i]) * other + carry;
-		m_container[i] = product; // use truncation
-		carry = product >> 64;
+	if(other == 0) {
+		// the product would keep zero limbs on top, which the digit counts of to_string trip on
+		m_digits = 1;
+		m_container[0] = 0;
+		return *this;
 	}
+	const base_t carry = limbs::mul_1(m_container.data(), m_container.data(), m_digits, other);
 
 	if(carry) {
 		if(m_digits < m_container.size()) {
@@ -212,6 +277,10 @@ UnsignedBigInt& UnsignedBigInt::operator<<=(const uint64_t& other) {
 	const size_t required_size = m_digits + base_shift + (bit_shift != 0);
 
 	m_container.resize(required_size, 0);
+	if(bit_shift != 0) {
+		// the top limb only receives spilled bits, clear anything stale left there
+		m_container[required_size - 1] = 0;
+	}
 
 	for(int i = m_digits - 1; i >= 0; i--) {
 		// start on rightmost digit
@@ -221,7 +290,9 @@ UnsignedBigInt& UnsignedBigInt::operator<<=(const uint64_t& other) {
 
 		// because we're going from right to left, assume upper half is already set
 		// so need to or
-		m_container[i + base_shift + 1] |= upper_half;
+		if(static_cast<size_t>(i) + base_shift + 1 < required_size) {
+			m_container[i + base_shift + 1] |= upper_half;
+		}
 		m_container[i + base_shift] = lower_half;
 	}
 
@@ -243,6 +314,12 @@ UnsignedBigInt& UnsignedBigInt::operator>>=(const uint64_t& other) {
 	const size_t base_shift = other / 64;
 	const size_t bit_shift = other % 64;
 
+	if(base_shift >= m_digits) {
+		// every set bit is shifted out
+		*this = 0;
+		return *this;
+	}
+
 	for(size_t i = 0; i < base_shift; i++) {
 		m_container[i] = 0;
 	}
@@ -275,32 +352,31 @@ UnsignedBigInt& UnsignedBigInt::operator>>=(const uint64_t& other) {
 // Section: assignment algebraic operations for big ints
 // ============================================================================
 UnsignedBigInt& UnsignedBigInt::operator+=(const UnsignedBigInt& other) {
-	size_t max_digit = std::max(m_digits, other.m_digits);
+	if(&other == this) {
+		// growing the container would move the operand
+		return *this <<= 1;
+	}
+	return add_limbs_eq(other.m_container.data(), other.m_digits);
+}
 
-	// reserve 1 more space to acnt for carry
-	m_container.reserve(max_digit + 1);
+UnsignedBigInt& UnsignedBigInt::add_limbs_eq(const base_t* b, size_t n) {
+	size_t max_digit = std::max(m_digits, n);
 
-	if(other.m_digits > m_digits) {
-		m_container.resize(other.m_digits, 0);
+	// reserve 1 more space to acnt for carry
+	if(m_container.size() < max_digit + 1) {
+		m_container.resize(max_digit + 1, 0);
 	}
 
-	__uint128_t carry = 0;
-	for(size_t i = 0; i < max_digit; i++) {
-		const __uint128_t lhs = m_container[i];
-		const __uint128_t rhs = other.m_container[i];
-		const __uint128_t sum = lhs + rhs + carry;
-
-		m_container[i] = sum & UnsignedBigInt::LOWER_MASK_128;
-		carry = sum >> 64;
+	base_t carry;
+	if(n > m_digits) {
+		carry = limbs::add(m_container.data(), b, n, m_container.data(), m_digits);
+	} else {
+		carry = limbs::add(m_container.data(), m_container.data(), m_digits, b, n);
 	}
 
 	m_digits = max_digit;
 	if(carry) {
-		if(m_digits < m_container.size()) {
-			m_container[m_digits] = carry;
-		} else {
-			m_container.push_back(carry);
-		}
+		m_container[m_digits] = carry;
 		m_digits++;
 	}
 
@@ -308,214 +384,260 @@ UnsignedBigInt& UnsignedBigInt::operator+=(const UnsignedBigInt& other) {
 }
 
 UnsignedBigInt& UnsignedBigInt::operator-=(const UnsignedBigInt& other) {
-	if(*this < other) {
+	if(!try_sub(other)) {
 		throw BigNumUnderflowException(*this, other);
 	}
+	return *this;
+}
 
-	uint64_t borrow = 0;
-	for(size_t i = 0; i < other.m_digits || borrow != 0; i++) {
-		// Get the current digit of b or 0 if we're beyond its size
-
-		const __uint128_t lhs = m_container[i];
-		const __uint128_t rhs = (i < other.m_digits) ? other.m_container[i] : 0;
+bool UnsignedBigInt::try_sub(const UnsignedBigInt& other) noexcept {
+	return try_sub_limbs(other.m_container.data(), other.m_digits);
+}
 
-		if(lhs >= rhs + borrow) {
-			// can absorb the subtraction
-			m_container[i] = lhs - borrow - rhs;
-			borrow = 0;
-		} else {
-			// do the subtraction first to avoid overflow
-			m_container[i] += ((UnsignedBigInt::MAX_U64_VALUE - rhs) - borrow) + 1;
-			borrow = 1;
-		}
+bool UnsignedBigInt::try_sub_limbs(const base_t* b, size_t n) noexcept {
+	if(n > m_digits) {
+		return false;
 	}
 
-	if(m_digits != 1 && m_container[m_digits - 1] == 0) {
-		// if we borrowed from the highest digit,
-		// we need to check if we decreased the number of digits
-		// in the number
-		m_digits--;
+	// one borrow chain over b's limbs, then in place up the rest until the borrow is absorbed.
+	// a borrow out of the top means b was larger, adding it back undoes that
+	base_t* out = m_container.data();
+	base_t borrow = limbs::sub(out, out, n, b, n);
+	for(size_t i = n; borrow && i < m_digits; i++) {
+		borrow = out[i] == 0;
+		out[i]--;
+	}
+	if(borrow) {
+		limbs::add(out, out, m_digits, b, n);
+		return false;
 	}
 
-	return *this;
+	normalize();
+	return true;
 }
 
 UnsignedBigInt& UnsignedBigInt::operator*=(const UnsignedBigInt& other) {
+	if(&other == this) {
+		return square_eq();
+	}
+	return mul_limbs_eq(other.m_container.data(), other.m_digits);
+}
 
-	container buffer(m_digits + other.m_digits, 0);
+UnsignedBigInt& UnsignedBigInt::mul_limbs_eq(const base_t* b, size_t n) {
+	// kernels expect the longer operand first
+	const base_t* a = m_container.data();
+	const bool longer = m_digits >= n;
+	const size_t size = m_digits + n;
+	Workspace::Frame frame(current_workspace());
+	base_t* product = frame.take(size);
+	base_t* scratch = frame.take(mul_scratch_size(std::max(m_digits, n), std::min(m_digits, n)));
 
-	__uint128_t carry = 0;
-	for(size_t i = 0; i < m_digits; i++) {
-		for(size_t j = 0; j < other.m_digits; j++) {
-			const __uint128_t& lhs = m_container[i];
-			const __uint128_t& rhs = other.m_container[j];
-			const __uint128_t product = (lhs * rhs) + carry + buffer[i + j];
-			carry = product >> 64;
-			buffer[i + j] = product & UnsignedBigInt::LOWER_MASK_128;
-		}
-
-		if(carry) {
-			buffer[i + other.m_digits] += carry;
-			carry = 0;
-		}
+	if(longer) {
+		mul_limbs(product, a, m_digits, b, n, scratch);
+	} else {
+		mul_limbs(product, b, n, a, m_digits, scratch);
 	}
 
-	m_digits = buffer.size() - ((buffer.back() == 0) ? 1 : 0);
-	m_container = std::move(buffer);
+	// the operands may live in this value, so the product only moves in once it is complete
+	m_container.assign(product, product + size);
+	m_digits = size;
+	normalize();
 	return *this;
 }
 
-UnsignedBigInt& UnsignedBigInt::operator/=(const UnsignedBigInt& other) {
-	if(other == UnsignedBigInt(0)) {
-		throw BigNumDivideByZeroException();
+UnsignedBigInt& UnsignedBigInt::addmul_eq(const UnsignedBigInt& a, const UnsignedBigInt& b) {
+	if(&a == this || &b == this) {
+		return *this += a * b;
 	}
-
-	if(*this < other) {
-		*this = 0;
+	if(a == UnsignedBigInt(0) || b == UnsignedBigInt(0)) {
 		return *this;
 	}
 
-	if(*this == other) {
-		*this = 1;
-		return *this;
+	const UnsignedBigInt& lhs = a.m_digits >= b.m_digits ? a : b;
+	const UnsignedBigInt& rhs = a.m_digits >= b.m_digits ? b : a;
+	const size_t an = lhs.m_digits;
+	const size_t bn = rhs.m_digits;
+	const base_t* ap = lhs.m_container.data();
+	const base_t* bp = rhs.m_container.data();
+
+	// one spare limb absorbs the final carry, limbs past m_digits may be stale
+	const size_t size = std::max(m_digits, an + bn) + 1;
+	if(m_container.size() < size) {
+		m_container.resize(size);
+	}
+	std::fill(m_container.begin() + m_digits, m_container.begin() + size, 0);
+	base_t* out = m_container.data();
+
+	if(bn < KARATSUBA_THRESHOLD) {
+		for(size_t i = 0; i < bn; i++) {
+			base_t carry = limbs::addmul_1(out + i, ap, an, bp[i]);
+			for(size_t j = i + an; carry; j++) {
+				out[j] += carry;
+				carry = out[j] < carry;
+			}
+		}
+	} else {
+		Workspace::Frame frame(current_workspace());
+		base_t* product = frame.take(an + bn);
+		mul_limbs(product, ap, an, bp, bn, frame.take(mul_scratch_size(an, bn)));
+		limbs::add(out, out, size, product, an + bn);
 	}
 
-	UnsignedBigInt dividend = *this;
-	UnsignedBigInt divisor = other;
-	UnsignedBigInt quotient;
-
-	quotient.m_container.resize(dividend.m_digits, 0);
-	quotient.m_digits = dividend.m_digits;
-
-	// std::cout << "checking bit alignment" << std::endl;
-	// std::cout << dividend.to_bitstring() << std::endl;
-	// std::cout << divisor.to_bitstring() << std::endl;
+	m_digits = size;
+	normalize();
+	return *this;
+}
 
-	int shift = dividend.most_significant_bit() - divisor.most_significant_bit();
-	divisor <<= shift;
+UnsignedBigInt& UnsignedBigInt::submul_eq(const UnsignedBigInt& a, const UnsignedBigInt& b) {
+	if(&a == this || &b == this) {
+		return *this -= a * b;
+	}
+	if(a == UnsignedBigInt(0) || b == UnsignedBigInt(0)) {
+		return *this;
+	}
 
-	// std::cout << dividend.to_bitstring() << std::endl;
-	// std::cout << divisor.to_bitstring() << std::endl;
+	const UnsignedBigInt& lhs = a.m_digits >= b.m_digits ? a : b;
+	const UnsignedBigInt& rhs = a.m_digits >= b.m_digits ? b : a;
+	const size_t an = lhs.m_digits;
+	const size_t bn = rhs.m_digits;
+	const base_t* ap = lhs.m_container.data();
+	const base_t* bp = rhs.m_container.data();
+
+	// the product is at least B^(an + bn - 2)
+	if(an + bn - 1 > m_digits) {
+		throw BigNumUnderflowException(*this, a * b);
+	}
+
+	const size_t size = std::max(m_digits, an + bn);
+	if(m_container.size() < size) {
+		m_container.resize(size);
+	}
+	std::fill(m_container.begin() + m_digits, m_container.begin() + size, 0);
+	base_t* out = m_container.data();
+
+	if(bn < KARATSUBA_THRESHOLD) {
+		// rows wrap around modulo B^size, any borrow out of the top means a * b > *this
+		bool underflow = false;
+		for(size_t i = 0; i < bn; i++) {
+			base_t borrow = limbs::submul_1(out + i, ap, an, bp[i]);
+			for(size_t j = i + an; borrow && j < size; j++) {
+				const base_t limb = out[j];
+				out[j] = limb - borrow;
+				borrow = limb < borrow;
+			}
+			underflow |= borrow != 0;
+		}
 
-	for(int i = shift; i >= 0; i--) {
-		if(dividend >= divisor) {
-			dividend -= divisor;
-			quotient.set_bit(i, 1);
+		if(underflow) {
+			// adding the rows back modulo B^size restores the original value
+			for(size_t i = 0; i < bn; i++) {
+				base_t carry = limbs::addmul_1(out + i, ap, an, bp[i]);
+				for(size_t j = i + an; carry && j < size; j++) {
+					out[j] += carry;
+					carry = out[j] < carry;
+				}
+			}
+			throw BigNumUnderflowException(*this, a * b);
 		}
-		divisor >>= 1;
+	} else {
+		Workspace::Frame frame(current_workspace());
+		base_t* product = frame.take(an + bn);
+		mul_limbs(product, ap, an, bp, bn, frame.take(mul_scratch_size(an, bn)));
+		if(limbs::compare(out, size, product, an + bn) < 0) {
+			throw BigNumUnderflowException(*this, a * b);
+		}
+		limbs::sub(out, out, size, product, an + bn);
 	}
 
-	*this = quotient;
+	m_digits = size;
+	normalize();
+	return *this;
+}
 
-	// normalize
-	while(m_digits > 1 && m_container[m_digits - 1] == 0) {
-		m_digits--;
-	}
+UnsignedBigInt& UnsignedBigInt::operator/=(const UnsignedBigInt& other) {
+	*this = divmod(other).first;
+	return *this;
+}
+
+UnsignedBigInt& UnsignedBigInt::square_eq() {
+	const size_t size = 2 * m_digits;
+	Workspace::Frame frame(current_workspace());
+	base_t* square = frame.take(size);
+
+	sqr_n(square, m_container.data(), m_digits, frame.take(mul_n_scratch_size(m_digits)));
 
+	m_container.assign(square, square + size);
+	m_digits = size;
+	normalize();
 	return *this;
 }
 
 UnsignedBigInt& UnsignedBigInt::operator^=(const UnsignedBigInt& other) {
 	UnsignedBigInt res = 1;
-	UnsignedBigInt n = other;
 
-	while(n > UnsignedBigInt(0)) {
-		int last_bit = n.m_container[0] & 1;
-		if(last_bit) {
-			res *= (*this);
+	// left to right binary exponentiation, the squarings run on the dedicated kernels
+	if(other != UnsignedBigInt(0)) {
+		for(size_t i = other.most_significant_bit(); i > 0; i--) {
+			res.square_eq();
+			if(other.get_bit(i - 1)) {
+				res *= *this;
+			}
 		}
-		*this *= *this;
-		n >>= 1;
 	}
 
-	*this = res;
+	*this = std::move(res);
 	return *this;
 }
 
 UnsignedBigInt& UnsignedBigInt::operator%=(const UnsignedBigInt& other) {
-	if(other == UnsignedBigInt(0)) {
-		throw BigNumDivideByZeroException();
-	}
-
-	if(*this == other) {
-		*this = 0;
-		return *this;
-	}
-
-	if(*this < other) {
-		return *this;
-	}
-
-	UnsignedBigInt divisor = other;
-	int shift = most_significant_bit() - divisor.most_significant_bit();
-	divisor <<= shift;
-
-	for(int i = shift; i >= 0; --i) {
-		if(*this >= divisor) {
-			*this -= divisor;
-		}
-		divisor >>= 1;
-	}
-
-	// normalize
-	while(m_digits > 1 && m_container[m_digits - 1] == 0) {
-		m_digits--;
-	}
-
+	*this = divmod(other).second;
 	return *this;
 }
 
 UnsignedBigInt& UnsignedBigInt::modulus_exp_eq(const UnsignedBigInt& exp,
 											   const UnsignedBigInt& mod) {
-
-	UnsignedBigInt save = *this % mod;
-	*this = 1;
-	*this %= mod;
-
-	for(UnsignedBigInt i = 0; i < exp; i += 1) {
-		*this *= save;
-		*this %= mod;
+	if(mod.m_container[0] & 1) {
+		// odd moduli reduce without division in montgomery form
+		*this = MontgomeryContext(mod).pow(*this, exp);
+		return *this;
 	}
 
+	// even moduli (and zero, which throws) go through barrett reduction instead
+	*this = BarrettContext(mod).pow(*this, exp);
 	return *this;
 }
 
 // ============================================================================
 // Section: operators
 // ============================================================================
-bool UnsignedBigInt::operator<(const UnsignedBigInt& other) const {
+std::strong_ordering UnsignedBigInt::operator<=>(const UnsignedBigInt& other) const noexcept {
 	if(m_digits != other.m_digits) {
-		return m_digits < other.m_digits;
+		return m_digits <=> other.m_digits;
 	}
 
 	for(size_t i = m_digits; i > 0; i--) {
 		if(m_container[i - 1] != other.m_container[i - 1]) {
-			return m_container[i - 1] < other.m_container[i - 1];
+			return m_container[i - 1] <=> other.m_container[i - 1];
 		}
 	}
 
-	return false;
+	return std::strong_ordering::equal;
 }
 
-bool UnsignedBigInt::operator>(const UnsignedBigInt& other) const {
-	if(m_digits != other.m_digits) {
-		return m_digits > other.m_digits;
-	}
-
-	for(size_t i = m_digits; i > 0; i--) {
-		if(m_container[i - 1] != other.m_container[i - 1]) {
-			return m_container[i - 1] > other.m_container[i - 1];
-		}
-	}
+bool UnsignedBigInt::operator<(const UnsignedBigInt& other) const {
+	return (*this <=> other) < 0;
+}
 
-	return false;
+bool UnsignedBigInt::operator>(const UnsignedBigInt& other) const {
+	return (*this <=> other) > 0;
 }
 
 bool UnsignedBigInt::operator<=(const UnsignedBigInt& other) const {
-	return !(*this > other);
+	return (*this <=> other) <= 0;
 }
+
 bool UnsignedBigInt::operator>=(const UnsignedBigInt& other) const {
-	return !(*this < other);
+	return (*this <=> other) >= 0;
 }
 
 bool UnsignedBigInt::operator==(const UnsignedBigInt& other) const {
@@ -539,51 +661,6 @@ bool UnsignedBigInt::operator!=(const UnsignedBigInt& other) const {
 // Section: helpers
 // ============================================================================
 
-std::string UnsignedBigInt::to_string() const {
-	const uint64_t BASE = 1000000000000000000ULL;
-	std::vector<uint64_t> result;
-
-	for(int i = m_digits - 1; i >= 0; i--) {
-		uint64_t carry = m_container[i];
-
-		for(size_t j = 0; j < result.size(); j++) {
-			// Perform the multiplication and addition, ensuring the result fits in 128 bits
-			__uint128_t temp = (static_cast<__uint128_t>(result[j]) << 64) + carry;
-			result[j] = static_cast<uint64_t>(temp % BASE);
-			carry = static_cast<uint64_t>(temp / BASE);
-		}
-
-		// Push any remaining carry as a new digit
-		while(carry > 0) {
-			result.push_back(carry % BASE);
-			carry /= BASE;
-		}
-	}
-	// Convert the result to a string
-	std::string base10;
-	if(result.empty()) {
-		return "0";
-	}
-
-	base10 = std::to_string(result.back());
-	for(int i = result.size() - 2; i >= 0; --i) {
-		std::string part = std::to_string(result[i]);
-		base10 += std::string(18 - part.length(), '0') + part;
-	}
-
-	return base10;
-}
-
-std::string UnsignedBigInt::to_bitstring() const {
-	std::stringstream ss;
-
-	for(int i = m_digits - 1; i >= 0; i--) {
-		ss << std::bitset<sizeof(uint64_t) * 8>(m_container[i]) << ' ';
-	}
-
-	return ss.str();
-}
-
 size_t UnsignedBigInt::digits() const noexcept {
 	return m_digits;
 }
@@ -594,6 +671,20 @@ size_t UnsignedBigInt::most_significant_bit() const noexcept {
 	return ret;
 }
 
+void UnsignedBigInt::normalize() noexcept {
+	while(m_digits > 1 && m_container[m_digits - 1] == 0) {
+		m_digits--;
+	}
+}
+
+bool UnsignedBigInt::get_bit(size_t idx) const noexcept {
+	const size_t block = idx / 64;
+	if(block >= m_digits) {
+		return false;
+	}
+	return (m_container[block] >> (idx % 64)) & 1;
+}
+
 void UnsignedBigInt::set_bit(size_t idx, bool on) noexcept {
 	size_t block = idx / 64;
 	size_t shift = idx % 64;
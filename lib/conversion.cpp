@@ -0,0 +1,487 @@
+#include "include/bignum.hpp"
+#include "include/limbs.hpp"
+#include "include/radix_cache.hpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define SSSE3_KERNELS 1
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+
+using namespace limbs;
+using radix_cache::MAX_BASE;
+
+// ============================================================================
+// Section: digit kernels
+// ============================================================================
+namespace {
+
+// decimal digits in a leaf limb, 10^19 < 2^64. the cached powers of ten use the same leaves
+constexpr size_t LEAF_DIGITS = 19;
+constexpr limb_t LEAF_BASE = 10000000000000000000ull;
+static_assert(LEAF_DIGITS == radix_cache::leaf_digits(10));
+static_assert(LEAF_BASE == radix_cache::leaf_base(10));
+
+/// @brief whether all eight bytes of chunk are ascii digits: the high nibbles must be 3, and
+/// adding 6 must not carry the low nibbles past 9
+inline bool is_eight_digits(uint64_t chunk) {
+	return ((chunk & 0xF0F0F0F0F0F0F0F0ull) |
+			(((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+		   0x3333333333333333ull;
+}
+
+/// @brief value of eight ascii digits loaded little endian, so the first digit is in the low
+/// byte. neighbouring digits, pairs and quads are merged with one multiplication each
+inline uint64_t parse_eight(uint64_t chunk) {
+	chunk = (chunk & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+	chunk = (chunk & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+	return (chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32;
+}
+
+/// @brief value of n <= 19 decimal digits, eight at a time and the rest one by one
+limb_t parse_leaf(const char* digits, size_t n) {
+	assert(n <= LEAF_DIGITS);
+	limb_t ret = 0;
+	for(; n >= 8; digits += 8, n -= 8) {
+		uint64_t chunk;
+		std::memcpy(&chunk, digits, sizeof(chunk));
+		if(!is_eight_digits(chunk)) {
+			throw BigNumInvalidDigitException();
+		}
+		ret = ret * 100000000 + parse_eight(chunk);
+	}
+	for(; n > 0; digits++, n--) {
+		const limb_t digit = static_cast<unsigned char>(*digits) - limb_t('0');
+		if(digit > 9) {
+			throw BigNumInvalidDigitException();
+		}
+		ret = ret * 10 + digit;
+	}
+	return ret;
+}
+
+/// @brief value of every character as a digit, letters in either case, and 0xFF for the rest
+constexpr std::array<uint8_t, 256> DIGIT_VALUES = []() {
+	std::array<uint8_t, 256> ret {};
+	ret.fill(0xFF);
+	for(uint8_t i = 0; i < 10; i++) {
+		ret['0' + i] = i;
+	}
+	for(uint8_t i = 0; i < 26; i++) {
+		ret['a' + i] = 10 + i;
+		ret['A' + i] = 10 + i;
+	}
+	return ret;
+}();
+
+constexpr char DIGIT_CHARS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/// @brief value of one character as a digit of base
+inline limb_t digit_value(char digit, unsigned base) {
+	const limb_t value = DIGIT_VALUES[static_cast<unsigned char>(digit)];
+	if(value >= base) {
+		throw BigNumInvalidDigitException();
+	}
+	return value;
+}
+
+/// @brief value of n digits in base, at most the leaf digits of base
+limb_t parse_leaf(const char* digits, size_t n, unsigned base) {
+	if(base == 10) {
+		return parse_leaf(digits, n);
+	}
+	limb_t ret = 0;
+	for(; n > 0; digits++, n--) {
+		ret = ret * base + digit_value(*digits, base);
+	}
+	return ret;
+}
+
+/// @brief the leaf of a base and the reciprocal dividing by it. a leaf below 2^63 is shifted
+/// up for the reciprocal, and the dividend with it (moller and granlund, "improved division by
+/// invariant integers")
+struct Radix {
+	limb_t leaf_base;
+	limb_t inverse; // of leaf_base << shift
+	size_t digits;
+	unsigned shift;
+};
+
+constexpr std::array<Radix, MAX_BASE + 1> RADICES = []() {
+	std::array<Radix, MAX_BASE + 1> ret {};
+	for(unsigned base = 2; base <= MAX_BASE; base++) {
+		Radix& radix = ret[base];
+		radix.leaf_base = radix_cache::leaf_base(base);
+		radix.digits = radix_cache::leaf_digits(base);
+		radix.shift = std::countl_zero(radix.leaf_base);
+		const limb_t normalized = radix.leaf_base << radix.shift;
+		radix.inverse = static_cast<limb_t>(~static_cast<__uint128_t>(0) / normalized);
+	}
+	return ret;
+}();
+
+/// @brief q[0..n] = a / leaf_base, q may equal a
+/// @return the remainder
+limb_t divrem_leaf(limb_t* q, const limb_t* a, size_t n, const Radix& radix) {
+	const unsigned shift = radix.shift;
+	const limb_t divisor = radix.leaf_base << shift;
+	// the bits shifted out of the top limb start the remainder. shifting by 64 - shift in two
+	// steps keeps a zero shift defined
+	limb_t rem = a[n - 1] >> 1 >> (63 - shift);
+	for(size_t i = n; i > 0; i--) {
+		const limb_t next = i > 1 ? a[i - 2] : 0;
+		const limb_t limb = (a[i - 1] << shift) | (next >> 1 >> (63 - shift));
+		const __uint128_t estimate = static_cast<__uint128_t>(radix.inverse) * rem +
+									 ((static_cast<__uint128_t>(rem) << 64) | limb);
+		limb_t quotient = static_cast<limb_t>(estimate >> 64) + 1;
+		rem = limb - quotient * divisor;
+		if(rem > static_cast<limb_t>(estimate)) {
+			quotient--;
+			rem += divisor;
+		}
+		if(rem >= divisor) {
+			quotient++;
+			rem -= divisor;
+		}
+		q[i - 1] = quotient;
+	}
+	return rem >> shift;
+}
+
+/// @brief "00" to "99" back to back, so a pair of digits is one two byte copy
+constexpr std::array<char, 200> DIGIT_PAIRS = []() {
+	std::array<char, 200> ret {};
+	for(size_t i = 0; i < 100; i++) {
+		ret[2 * i] = static_cast<char>('0' + i / 10);
+		ret[2 * i + 1] = static_cast<char>('0' + i % 10);
+	}
+	return ret;
+}();
+
+/// @brief writes the low width <= 19 decimal digits of value to out, zero padded, two at a
+/// time from the right
+inline void write_leaf(char* out, limb_t value, size_t width) {
+	assert(width <= LEAF_DIGITS);
+	char* end = out + width;
+	for(; end - out >= 2; end -= 2) {
+		std::memcpy(end - 2, &DIGIT_PAIRS[2 * (value % 100)], 2);
+		value /= 100;
+	}
+	if(end != out) {
+		out[0] = static_cast<char>('0' + value % 10);
+	}
+}
+
+/// @brief writes the low width digits of value in base to out, zero padded
+inline void write_leaf(char* out, limb_t value, size_t width, unsigned base) {
+	if(base == 10) {
+		write_leaf(out, value, width);
+		return;
+	}
+	for(char* end = out + width; end != out; end--) {
+		end[-1] = DIGIT_CHARS[value % base];
+		value /= base;
+	}
+}
+
+} // namespace
+
+// ============================================================================
+// Section: power of two bases
+// ============================================================================
+namespace {
+
+/// @brief bits per digit of a power of two base, zero for the other bases
+unsigned digit_bits(unsigned base) {
+	return std::has_single_bit(base) ? std::countr_zero(base) : 0;
+}
+
+/// @brief out = the value of the n digits of bits bits each at digits, packed from the right
+/// @param out at least (n * bits + 63) / 64 + 1 limbs
+/// @return limbs of the result without leading zeros, at least one
+size_t parse_power_of_two(limb_t* out, const char* digits, size_t n, unsigned bits) {
+	const unsigned base = 1u << bits;
+	size_t size = 0;
+	limb_t limb = 0;
+	unsigned filled = 0;
+	for(size_t i = n; i > 0; i--) {
+		const limb_t value = digit_value(digits[i - 1], base);
+		limb |= value << filled;
+		filled += bits;
+		if(filled >= 64) {
+			// the digit's high bits that did not fit start the next limb
+			out[size++] = limb;
+			filled -= 64;
+			limb = filled ? value >> (bits - filled) : 0;
+		}
+	}
+	out[size++] = limb;
+	while(size > 1 && out[size - 1] == 0) {
+		size--;
+	}
+	return size;
+}
+
+/// @brief writes the n limbs at a as exactly width digits of bits bits each, zero padded
+void format_power_of_two(char* out, size_t width, const limb_t* a, size_t n, unsigned bits) {
+	const limb_t mask = (limb_t(1) << bits) - 1;
+	for(size_t j = 0; j < width; j++) {
+		// digit j counts from the right and may straddle two limbs
+		const size_t bit = j * bits;
+		const size_t index = bit / 64;
+		const unsigned offset = bit % 64;
+		limb_t value = index < n ? a[index] >> offset : 0;
+		if(offset + bits > 64 && index + 1 < n) {
+			value |= a[index + 1] << (64 - offset);
+		}
+		out[width - 1 - j] = DIGIT_CHARS[value & mask];
+	}
+}
+
+/// @brief sixteen lowercase hex digits of value, most significant first. the nibbles are
+/// spread into bytes, and those past 9 moved up to the letters by the carry adding 6 leaves
+void write_hex_limb(char* out, limb_t value) {
+	for(unsigned shift : { 32, 0 }) {
+		uint64_t spread = static_cast<uint32_t>(value >> shift);
+		spread = (spread | spread << 16) & 0x0000FFFF0000FFFFull;
+		spread = (spread | spread << 8) & 0x00FF00FF00FF00FFull;
+		spread = (spread | spread << 4) & 0x0F0F0F0F0F0F0F0Full;
+		const uint64_t letters = ((spread + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+		// nibble i sits in byte i, the byte swap puts the top one first in memory
+		const uint64_t ascii =
+			__builtin_bswap64(spread + 0x3030303030303030ull + letters * ('a' - '0' - 10));
+		std::memcpy(out, &ascii, sizeof(ascii));
+		out += sizeof(ascii);
+	}
+}
+
+#if SSSE3_KERNELS
+/// @brief one byte swapped limb at a time, its high and low nibbles interleaved and looked up
+/// sixteen at once with a byte shuffle
+SSSE3_TARGET void format_hex_ssse3(char* out, const limb_t* a, size_t n) {
+	const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(DIGIT_CHARS));
+	const __m128i low_nibbles = _mm_set1_epi8(0x0F);
+	for(size_t i = n; i > 0; i--, out += 16) {
+		const long long limb = static_cast<long long>(__builtin_bswap64(a[i - 1]));
+		const __m128i bytes = _mm_cvtsi64_si128(limb);
+		const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibbles);
+		const __m128i low = _mm_and_si128(bytes, low_nibbles);
+		const __m128i digits = _mm_shuffle_epi8(table, _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), digits);
+	}
+}
+
+bool ssse3_supported() {
+	static const bool cpu = __builtin_cpu_supports("ssse3");
+	return cpu;
+}
+#endif
+
+/// @brief writes the n limbs at a as 16 * n hex digits, zero padded
+void format_hex(char* out, const limb_t* a, size_t n) {
+#if SSSE3_KERNELS
+	if(ssse3_supported()) {
+		format_hex_ssse3(out, a, n);
+		return;
+	}
+#endif
+	for(size_t i = n; i > 0; i--, out += 16) {
+		write_hex_limb(out, a[i - 1]);
+	}
+}
+
+} // namespace
+
+// ============================================================================
+// Section: sizes
+// ============================================================================
+size_t UnsignedBigInt::radix_limbs(size_t digits, unsigned base) noexcept {
+	// every leaf adds at most one limb, and the parser's products take up to two limbs past the
+	// value
+	const size_t leaf = RADICES[base].digits;
+	return (digits + leaf - 1) / leaf + 2;
+}
+
+// ============================================================================
+// Section: parsing
+// ============================================================================
+UnsignedBigInt UnsignedBigInt::from_string(std::string_view digits, unsigned base) {
+	UnsignedBigInt ret;
+	ret.parse(digits, base);
+	return ret;
+}
+
+void UnsignedBigInt::parse(std::string_view digits, unsigned base) {
+	if(base < 2 || base > MAX_BASE) {
+		throw BigNumInvalidBaseException();
+	}
+	if(digits.empty()) {
+		return;
+	}
+
+	if(const unsigned bits = digit_bits(base)) {
+		const size_t size = (digits.size() * bits + 63) / 64 + 1;
+		if(m_container.size() < size) {
+			m_container.resize(size, 0);
+		}
+		m_digits = parse_power_of_two(m_container.data(), digits.data(), digits.size(), bits);
+		return;
+	}
+
+	const size_t size = radix_limbs(digits.size(), base);
+	if(m_container.size() < size) {
+		m_container.resize(size, 0);
+	}
+	// short strings never split, so they need no powers
+	const radix_cache::Powers powers = digits.size() > PARSE_DC_THRESHOLD
+										   ? radix_cache::get(base, digits.size())
+										   : radix_cache::Powers();
+	m_digits = parse_radix(m_container.data(), digits.data(), digits.size(), base, powers);
+}
+
+size_t UnsignedBigInt::parse_radix(base_t* out, const char* digits, size_t n, unsigned base,
+								   const radix_cache::Powers& powers) {
+	const Radix& radix = RADICES[base];
+	if(n <= PARSE_DC_THRESHOLD) {
+		// a leading partial leaf, then whole ones folded in as value * leaf_base + leaf
+		const size_t head = n % radix.digits != 0 ? n % radix.digits : std::min(n, radix.digits);
+		out[0] = parse_leaf(digits, head, base);
+		size_t size = 1;
+		for(size_t i = head; i < n; i += radix.digits) {
+			const limb_t leaf = parse_leaf(digits + i, radix.digits, base);
+			out[size] = mul_1(out, out, size, radix.leaf_base);
+			[[maybe_unused]] const limb_t carry = add(out, out, size + 1, &leaf, 1);
+			assert(carry == 0);
+			size += out[size] != 0;
+		}
+		while(size > 1 && out[size - 1] == 0) {
+			size--;
+		}
+		return size;
+	}
+
+	// the low part is the largest block of leaf * 2^k digits shorter than the string, so the
+	// high part is never longer than it
+	size_t k = 0;
+	while((radix.digits << (k + 1)) < n) {
+		k++;
+	}
+	assert(k < powers.size());
+	const size_t low_digits = radix.digits << k;
+	const size_t high_digits = n - low_digits;
+	const UnsignedBigInt& power = powers[k];
+
+	Workspace::Frame frame(current_workspace());
+	base_t* high = frame.take(radix_limbs(high_digits, base));
+	base_t* low = frame.take(radix_limbs(low_digits, base));
+	const size_t hn = parse_radix(high, digits, high_digits, base, powers);
+	const size_t ln = parse_radix(low, digits + high_digits, low_digits, base, powers);
+
+	// out = high * base^low_digits + low, the low part is below the power
+	const size_t pn = power.m_digits;
+	const base_t* pp = power.m_container.data();
+	const size_t size = hn + pn;
+	assert(size <= radix_limbs(n, base) && ln <= pn);
+	if(hn >= pn) {
+		mul_limbs(out, high, hn, pp, pn, frame.take(mul_scratch_size(hn, pn)));
+	} else {
+		mul_limbs(out, pp, pn, high, hn, frame.take(mul_scratch_size(pn, hn)));
+	}
+	[[maybe_unused]] const limb_t carry = add(out, out, size, low, ln);
+	assert(carry == 0);
+
+	size_t used = size;
+	while(used > 1 && out[used - 1] == 0) {
+		used--;
+	}
+	return used;
+}
+
+// ============================================================================
+// Section: formatting
+// ============================================================================
+std::string UnsignedBigInt::to_string(unsigned base) const {
+	if(base < 2 || base > MAX_BASE) {
+		throw BigNumInvalidBaseException();
+	}
+	if(m_digits == 1 && m_container[0] == 0) {
+		return "0";
+	}
+
+	const size_t bits = most_significant_bit();
+	std::string ret;
+	if(base == 16) {
+		ret.resize(16 * m_digits);
+		format_hex(ret.data(), m_container.data(), m_digits);
+	} else if(const unsigned digit_size = digit_bits(base)) {
+		ret.resize((bits + digit_size - 1) / digit_size);
+		format_power_of_two(ret.data(), ret.size(), m_container.data(), m_digits, digit_size);
+	} else {
+		size_t width;
+		if(base == 10) {
+			// log10(2) < 1292913987 / 2^32 by less than 2^-32, so the digits fit with at most
+			// one leading zero
+			width = static_cast<size_t>((static_cast<__uint128_t>(bits) * 1292913987) >> 32) + 1;
+		} else {
+			// the leaf base^m is at least 2^(63 - shift), so log2(base) >= (63 - shift) / m
+			const Radix& radix = RADICES[base];
+			width = bits * radix.digits / (63 - radix.shift) + 1;
+		}
+		const radix_cache::Powers powers =
+			m_digits > FORMAT_DC_THRESHOLD ? radix_cache::get(base, width) : radix_cache::Powers();
+		ret.resize(width);
+		format_radix(ret.data(), width, *this, base, powers);
+	}
+	ret.erase(0, ret.find_first_not_of('0'));
+	return ret;
+}
+
+std::string UnsignedBigInt::to_bitstring() const {
+	// all 64 bits of every limb, most significant first, each limb followed by a space
+	std::string ret(65 * m_digits, ' ');
+	for(size_t i = 0; i < m_digits; i++) {
+		format_power_of_two(&ret[65 * i], 64, &m_container[m_digits - 1 - i], 1, 1);
+	}
+	return ret;
+}
+
+void UnsignedBigInt::format_radix(char* out, size_t width, const UnsignedBigInt& value,
+								  unsigned base, const radix_cache::Powers& powers) {
+	const Radix& radix = RADICES[base];
+	if(value.m_digits <= FORMAT_DC_THRESHOLD) {
+		// peel off leaves from the right until the value runs out
+		Workspace::Frame frame(current_workspace());
+		base_t* rest = frame.take(value.m_digits);
+		std::copy(value.m_container.begin(), value.m_container.begin() + value.m_digits, rest);
+		size_t n = value.m_digits;
+		size_t end = width;
+		while(end > 0 && (n > 1 || rest[0] != 0)) {
+			const limb_t leaf = divrem_leaf(rest, rest, n, radix);
+			n -= n > 1 && rest[n - 1] == 0;
+			const size_t leaf_width = std::min(end, radix.digits);
+			write_leaf(out + end - leaf_width, leaf, leaf_width, base);
+			end -= leaf_width;
+		}
+		std::fill(out, out + end, '0');
+		return;
+	}
+
+	// the low block of leaf * 2^k digits is at least as long as the high one
+	size_t k = 0;
+	while((radix.digits << (k + 1)) < width) {
+		k++;
+	}
+	assert(k < powers.size());
+	const size_t low_width = radix.digits << k;
+	const auto [high, low] = value.divmod(powers[k]);
+	format_radix(out, width - low_width, high, base, powers);
+	format_radix(out + width - low_width, low_width, low, base, powers);
+}
@@ -0,0 +1,411 @@
+#include "include/bignum.hpp"
+#include "include/limbs.hpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+using namespace limbs;
+
+// ============================================================================
+// Section: limb kernels
+// ============================================================================
+UnsignedBigInt::base_t UnsignedBigInt::div_schoolbook(
+	base_t* q, base_t* n, size_t nn, const base_t* d, size_t dn) {
+	assert(dn >= 2 && nn >= dn);
+	assert(d[dn - 1] >> 63);
+
+	// the top dn limbs of n may exceed d once, after that every window is below d * B
+	const base_t qh = compare(n + nn - dn, dn, d, dn) >= 0;
+	if(qh) {
+		sub(n + nn - dn, n + nn - dn, dn, d, dn);
+	}
+
+	const base_t d1 = d[dn - 1];
+	const base_t d0 = d[dn - 2];
+	for(size_t i = nn - dn; i > 0; i--) {
+		// divide the dn + 1 limb window by d, its top limb is at most d1
+		base_t* window = n + i - 1;
+		const base_t n2 = window[dn];
+		const base_t n1 = window[dn - 1];
+		const base_t n0 = window[dn - 2];
+
+		// estimate from the top two limbs, then refine with d0. the estimate is never too
+		// small and at most one too large afterwards
+		base_t qhat;
+		__uint128_t rhat;
+		if(n2 >= d1) {
+			qhat = MAX_U64_VALUE;
+			rhat = static_cast<__uint128_t>(n1) + d1;
+		} else {
+			const __uint128_t top = (static_cast<__uint128_t>(n2) << 64) | n1;
+			qhat = static_cast<base_t>(top / d1);
+			rhat = top - static_cast<__uint128_t>(qhat) * d1;
+		}
+		while((rhat >> 64) == 0 &&
+			  static_cast<__uint128_t>(qhat) * d0 > ((rhat << 64) | n0)) {
+			qhat--;
+			rhat += d1;
+		}
+
+		const base_t borrow = submul_1(window, d, dn, qhat);
+		if(borrow > n2) {
+			// the window went negative, add one divisor back
+			qhat--;
+			add(window, window, dn, d, dn);
+		}
+		q[i - 1] = qhat;
+	}
+
+	return qh;
+}
+
+// ----------------------------------------------------------------------------
+// burnikel-ziegler
+// ----------------------------------------------------------------------------
+UnsignedBigInt::base_t UnsignedBigInt::div_bz_n(
+	base_t* q, base_t* n, const base_t* d, size_t dn, base_t* scratch) {
+	const size_t lo = dn / 2;
+	const size_t hi = dn - lo;
+	assert(lo >= 2);
+
+	base_t* product = scratch;
+	base_t* rest = scratch + dn;
+
+	// high quotient half: divide the top 2hi limbs by the top hi divisor limbs, then subtract
+	// the part of the quotient times the low divisor limbs that was left out. the estimate is
+	// never too small, so a negative remainder means adding the divisor back
+	base_t qh = hi < DIV_BZ_THRESHOLD ? div_schoolbook(q + lo, n + 2 * lo, 2 * hi, d + lo, hi)
+									  : div_bz_n(q + lo, n + 2 * lo, d + lo, hi, scratch);
+	mul_limbs(product, q + lo, hi, d, lo, rest);
+	base_t borrow = sub(n + lo, n + lo, dn, product, dn);
+	if(qh) {
+		borrow += sub(n + dn, n + dn, lo, d, lo);
+	}
+	while(borrow) {
+		qh -= sub_1(q + lo, q + lo, hi, 1);
+		borrow -= add(n + lo, n + lo, dn, d, dn);
+	}
+
+	// low quotient half from the remainder and the low lo numerator limbs
+	const base_t ql = lo < DIV_BZ_THRESHOLD ? div_schoolbook(q, n + hi, 2 * lo, d + hi, lo)
+											: div_bz_n(q, n + hi, d + hi, lo, scratch);
+	mul_limbs(product, d, hi, q, lo, rest);
+	borrow = sub(n, n, dn, product, dn);
+	if(ql) {
+		borrow += sub(n + lo, n + lo, hi, d, hi);
+	}
+	while(borrow) {
+		sub_1(q, q, lo, 1);
+		borrow -= add(n, n, dn, d, dn);
+	}
+
+	return qh;
+}
+
+UnsignedBigInt::base_t UnsignedBigInt::div_bz_short(
+	base_t* q, base_t* n, size_t nn, const base_t* d, size_t dn, base_t* scratch) {
+	const size_t qn = nn - dn;
+	assert(qn < dn);
+	if(qn < DIV_BZ_THRESHOLD) {
+		return div_schoolbook(q, n, nn, d, dn);
+	}
+
+	// the quotient only depends on the top 2qn numerator limbs and top qn divisor limbs up to
+	// a small correction from the s low divisor limbs
+	const size_t s = dn - qn;
+	base_t qh = div_bz_n(q, n + s, d + s, qn, scratch);
+
+	base_t* product = scratch;
+	base_t* rest = scratch + dn;
+	if(qn >= s) {
+		mul_limbs(product, q, qn, d, s, rest);
+	} else {
+		mul_limbs(product, d, s, q, qn, rest);
+	}
+	base_t borrow = sub(n, n, dn, product, dn);
+	if(qh) {
+		borrow += sub(n + qn, n + qn, s, d, s);
+	}
+	while(borrow) {
+		qh -= sub_1(q, q, qn, 1);
+		borrow -= add(n, n, dn, d, dn);
+	}
+
+	return qh;
+}
+
+UnsignedBigInt::base_t UnsignedBigInt::div_bz(
+	base_t* q, base_t* n, size_t nn, const base_t* d, size_t dn, base_t* scratch) {
+	const size_t qn = nn - dn;
+
+	// the leading block takes the quotient limbs that do not fill a whole block of dn, after it
+	// every block's numerator window is below d * B^dn
+	const size_t top = qn % dn;
+	base_t qh;
+	if(top) {
+		qh = div_bz_short(q + qn - top, n + qn - top, dn + top, d, dn, scratch);
+	} else {
+		qh = compare(n + qn, dn, d, dn) >= 0;
+		if(qh) {
+			sub(n + qn, n + qn, dn, d, dn);
+		}
+	}
+
+	for(size_t lo = qn - top; lo > 0;) {
+		lo -= dn;
+		[[maybe_unused]] const base_t carry = div_bz_n(q + lo, n + lo, d, dn, scratch);
+		assert(carry == 0);
+	}
+
+	return qh;
+}
+
+size_t UnsignedBigInt::div_bz_n_scratch_size(size_t n) noexcept {
+	if(n < DIV_BZ_THRESHOLD) {
+		return 0;
+	}
+	const size_t lo = n / 2;
+	const size_t hi = n - lo;
+	return std::max(div_bz_n_scratch_size(hi), n + mul_scratch_size(hi, lo));
+}
+
+size_t UnsignedBigInt::div_bz_short_scratch_size(size_t nn, size_t dn) noexcept {
+	const size_t qn = nn - dn;
+	if(qn < DIV_BZ_THRESHOLD) {
+		return 0;
+	}
+	const size_t s = dn - qn;
+	return std::max(div_bz_n_scratch_size(qn),
+					dn + mul_scratch_size(std::max(qn, s), std::min(qn, s)));
+}
+
+size_t UnsignedBigInt::div_bz_scratch_size(size_t nn, size_t dn) noexcept {
+	const size_t qn = nn - dn;
+	const size_t top = qn % dn;
+	size_t size = div_bz_short_scratch_size(dn + top, dn);
+	if(qn >= dn) {
+		size = std::max(size, div_bz_n_scratch_size(dn));
+	}
+	return size;
+}
+
+UnsignedBigInt UnsignedBigInt::from_limbs(const base_t* limbs, size_t n) {
+	UnsignedBigInt ret;
+	if(n > 0) {
+		ret.m_container.assign(limbs, limbs + n);
+		ret.m_digits = n;
+		ret.normalize();
+	}
+	return ret;
+}
+
+// ============================================================================
+// Section: newton reciprocal
+// ============================================================================
+// every step keeps x an underestimate of B^(2t) / dt, so the error term e below is never
+// negative. going from h = t / 2 + 1 to t limbs squares the relative error, which keeps the
+// absolute error at most 2 for every precision
+UnsignedBigInt UnsignedBigInt::reciprocal(const UnsignedBigInt& d, size_t t) {
+	const size_t dn = d.m_digits;
+	assert(t <= dn && d.m_container[dn - 1] >> 63);
+
+	UnsignedBigInt dt = d >> (64 * (dn - t));
+	dt += 1;
+
+	if(t < RECIPROCAL_BASE_THRESHOLD) {
+		return (UnsignedBigInt(1) << (128 * t)) / dt;
+	}
+
+	const size_t h = t / 2 + 1;
+	UnsignedBigInt x = reciprocal(d, h) << (64 * (t - h));
+
+	// x += x * (B^(2t) - dt * x) / B^(2t)
+	UnsignedBigInt e = UnsignedBigInt(1) << (128 * t);
+	e -= dt * x;
+	e.normalize();
+	x += (x * e) >> (128 * t);
+	return x;
+}
+
+std::pair<UnsignedBigInt, UnsignedBigInt> UnsignedBigInt::divmod_newton(
+	const UnsignedBigInt& divisor) const {
+	const unsigned shift = __builtin_clzll(divisor.m_container[divisor.m_digits - 1]);
+	const UnsignedBigInt d = divisor << shift;
+	const UnsignedBigInt n = *this << shift;
+
+	const size_t nn = n.m_digits;
+	const size_t dn = d.m_digits;
+	const size_t qn = nn - dn + 1;
+
+	// one reciprocal serves every block of t quotient limbs. a block divides rem * B^len plus
+	// the next len numerator limbs, which stays below d * B^len since rem < d
+	const size_t t = std::min(dn, qn);
+	const UnsignedBigInt x = reciprocal(d, t);
+
+	container q(qn, 0);
+	UnsignedBigInt rem = from_limbs(n.m_container.data() + qn, dn - 1);
+	for(size_t hi = qn; hi > 0;) {
+		const size_t len = std::min(t, hi);
+		const size_t lo = hi - len;
+
+		UnsignedBigInt a = rem << (64 * len);
+		a.normalize();
+		a += from_limbs(n.m_container.data() + lo, len);
+
+		// the estimate is never too large and at most a few units too small
+		UnsignedBigInt qhat = ((a >> (64 * (dn - 1))) * x) >> (64 * (t + 1));
+		rem = a - qhat * d;
+		rem.normalize();
+		while(rem >= d) {
+			qhat += 1;
+			rem -= d;
+			rem.normalize();
+		}
+
+		assert(qhat.m_digits <= len || qhat == UnsignedBigInt(0));
+		std::copy(qhat.m_container.begin(),
+				  qhat.m_container.begin() + std::min(qhat.m_digits, len),
+				  q.begin() + lo);
+		hi = lo;
+	}
+
+	UnsignedBigInt quotient;
+	quotient.m_container = std::move(q);
+	quotient.m_digits = qn;
+	quotient.normalize();
+
+	return { quotient, rem >> shift };
+}
+
+// ============================================================================
+// Section: division
+// ============================================================================
+std::pair<UnsignedBigInt, UnsignedBigInt> UnsignedBigInt::divmod(
+	const UnsignedBigInt& divisor) const {
+	if(divisor == UnsignedBigInt(0)) {
+		throw BigNumDivideByZeroException();
+	}
+
+	if(*this < divisor) {
+		return { UnsignedBigInt(0), *this };
+	}
+
+	const size_t nn = m_digits;
+	const size_t dn = divisor.m_digits;
+	UnsignedBigInt quotient;
+	UnsignedBigInt remainder;
+
+	if(dn == 1) {
+		quotient.m_container.resize(nn);
+		remainder = divrem_1(
+			quotient.m_container.data(), m_container.data(), nn, divisor.m_container[0]);
+
+		quotient.m_digits = nn;
+		quotient.normalize();
+		return { quotient, remainder };
+	}
+
+	if(std::min(dn, nn - dn + 1) >= DIV_NEWTON_THRESHOLD) {
+		return divmod_newton(divisor);
+	}
+
+	// shift both operands so the divisor's top bit is set, the numerator gains a limb for the
+	// bits shifted out of it
+	const unsigned shift = __builtin_clzll(divisor.m_container[dn - 1]);
+	Workspace::Frame frame(current_workspace());
+	base_t* d = frame.take(dn);
+	base_t* n = frame.take(nn + 1);
+	if(shift) {
+		lshift(d, divisor.m_container.data(), dn, shift);
+		n[nn] = lshift(n, m_container.data(), nn, shift);
+	} else {
+		std::copy(divisor.m_container.begin(), divisor.m_container.begin() + dn, d);
+		std::copy(m_container.begin(), m_container.begin() + nn, n);
+		n[nn] = 0;
+	}
+
+	// the quotient goes straight into its value, the remainder is copied out of the numerator
+	quotient.m_container.resize(nn + 1 - dn);
+	base_t* q = quotient.m_container.data();
+	[[maybe_unused]] base_t qh;
+	if(std::min(dn, nn + 1 - dn) >= DIV_BZ_THRESHOLD) {
+		qh = div_bz(q, n, nn + 1, d, dn, frame.take(div_bz_scratch_size(nn + 1, dn)));
+	} else {
+		qh = div_schoolbook(q, n, nn + 1, d, dn);
+	}
+	assert(qh == 0);
+	if(shift) {
+		rshift(n, n, dn, shift);
+	}
+
+	quotient.m_digits = nn + 1 - dn;
+	quotient.normalize();
+
+	remainder.m_container.assign(n, n + dn);
+	remainder.m_digits = dn;
+	remainder.normalize();
+
+	return { quotient, remainder };
+}
+
+UnsignedBigInt& UnsignedBigInt::mulmod_eq(const UnsignedBigInt& other, const UnsignedBigInt& mod) {
+	if(mod == UnsignedBigInt(0)) {
+		throw BigNumDivideByZeroException();
+	}
+
+	const UnsignedBigInt& lhs = m_digits >= other.m_digits ? *this : other;
+	const UnsignedBigInt& rhs = m_digits >= other.m_digits ? other : *this;
+	const size_t an = lhs.m_digits;
+	const size_t bn = rhs.m_digits;
+	const size_t pn = an + bn;
+	const size_t dn = mod.m_digits;
+	if(pn >= dn && std::min(dn, pn - dn + 1) >= DIV_NEWTON_THRESHOLD) {
+		*this *= other;
+		return *this %= mod;
+	}
+
+	// the product is formed one limb below the spare numerator limb the normalizing shift needs
+	Workspace::Frame frame(current_workspace());
+	base_t* n = frame.take(pn + 1);
+	mul_limbs(n, lhs.m_container.data(), an, rhs.m_container.data(), bn,
+			  frame.take(mul_scratch_size(an, bn)));
+	n[pn] = 0;
+
+	size_t rn = dn;
+	if(pn < dn) {
+		// already below the modulus
+		rn = pn;
+	} else if(dn == 1) {
+		n[0] = divrem_1(frame.take(pn), n, pn, mod.m_container[0]);
+	} else {
+		const unsigned shift = __builtin_clzll(mod.m_container[dn - 1]);
+		const base_t* d = mod.m_container.data();
+		if(shift) {
+			base_t* shifted = frame.take(dn);
+			lshift(shifted, d, dn, shift);
+			d = shifted;
+			n[pn] = lshift(n, n, pn, shift);
+		}
+
+		// only the remainder, left in the low dn numerator limbs, is kept
+		base_t* q = frame.take(pn + 1 - dn);
+		[[maybe_unused]] base_t qh;
+		if(std::min(dn, pn + 1 - dn) >= DIV_BZ_THRESHOLD) {
+			qh = div_bz(q, n, pn + 1, d, dn, frame.take(div_bz_scratch_size(pn + 1, dn)));
+		} else {
+			qh = div_schoolbook(q, n, pn + 1, d, dn);
+		}
+		assert(qh == 0);
+		if(shift) {
+			rshift(n, n, dn, shift);
+		}
+	}
+
+	// the operands may be this value or the modulus, so it only changes once they are read
+	m_container.assign(n, n + rn);
+	m_digits = rn;
+	normalize();
+	return *this;
+}
@@ -0,0 +1,312 @@
+#include "include/ifma.hpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define IFMA_KERNELS 1
+#define IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+#endif
+
+namespace ifma {
+
+namespace {
+
+constexpr uint64_t MASK52 = (uint64_t(1) << 52) - 1;
+
+// lanes per vector
+constexpr size_t LANES = 8;
+
+std::atomic<bool> use_kernels{ supported() };
+
+/// @brief 52 bit limbs of a montgomery value, rounded up to whole vectors
+size_t vector_limbs(size_t m) {
+	return (m + LANES - 1) / LANES * LANES;
+}
+
+/// @brief in[0..m] = in mod 2^(52m) with the limbs brought below 2^52
+/// @return the carry out of the top limb
+uint64_t normalize52(uint64_t* in, size_t m) {
+	uint64_t carry = 0;
+	for(size_t i = 0; i < m; i++) {
+		// the lanes stay well below 2^64 - 2^12, so adding the carry cannot wrap
+		const uint64_t sum = in[i] + carry;
+		in[i] = sum & MASK52;
+		carry = sum >> 52;
+	}
+	return carry;
+}
+
+/// @brief x[0..m] -= N if x + top * 2^(52m) >= N, for normalized 52 bit limbs
+void reduce_once(uint64_t* x, uint64_t top, const uint64_t* modulus, size_t m) {
+	uint64_t borrow = 0;
+	uint64_t* diff = x + m; // the caller leaves room for the difference above x
+	for(size_t i = 0; i < m; i++) {
+		const uint64_t d = x[i] - modulus[i] - borrow;
+		diff[i] = d & MASK52;
+		borrow = d >> 63;
+	}
+	if(top || !borrow) {
+		std::copy(diff, diff + m, x);
+	}
+}
+
+} // namespace
+
+// ============================================================================
+// Section: detection
+// ============================================================================
+bool supported() noexcept {
+#if IFMA_KERNELS
+	static const bool cpu = __builtin_cpu_supports("avx512f") &&
+		__builtin_cpu_supports("avx512ifma");
+	return cpu;
+#else
+	return false;
+#endif
+}
+
+bool enabled() noexcept {
+	return use_kernels.load(std::memory_order_relaxed);
+}
+
+void set_enabled(bool enable) noexcept {
+	assert(!enable || supported());
+	use_kernels.store(enable && supported(), std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Section: radix conversion
+// ============================================================================
+void pack52(uint64_t* out, size_t m, const uint64_t* in, size_t n) noexcept {
+	for(size_t i = 0; i < m; i++) {
+		const size_t bit = 52 * i;
+		const size_t word = bit / 64;
+		const unsigned shift = bit % 64;
+		if(word >= n) {
+			out[i] = 0;
+			continue;
+		}
+		uint64_t limb = in[word] >> shift;
+		if(shift > 12 && word + 1 < n) {
+			limb |= in[word + 1] << (64 - shift);
+		}
+		out[i] = limb & MASK52;
+	}
+}
+
+void unpack52(uint64_t* out, size_t n, const uint64_t* in, size_t m) noexcept {
+	__uint128_t bits = 0;
+	unsigned held = 0;
+	size_t word = 0;
+	for(size_t i = 0; i < m && word < n; i++) {
+		bits |= static_cast<__uint128_t>(in[i]) << held;
+		held += 52;
+		if(held >= 64) {
+			out[word++] = static_cast<uint64_t>(bits);
+			bits >>= 64;
+			held -= 64;
+		}
+	}
+	if(word < n) {
+		out[word++] = static_cast<uint64_t>(bits);
+	}
+	std::fill(out + word, out + n, 0);
+}
+
+// ============================================================================
+// Section: kernels
+// ============================================================================
+#if IFMA_KERNELS
+namespace {
+
+// columns one pass of the product kernel produces, four vectors of low and high halves
+constexpr size_t BLOCK = 4 * LANES;
+// zero limbs on either side of the padded first operand
+constexpr size_t PAD = BLOCK;
+
+/// @brief column sums of the product of a (52 bit limbs at padded + PAD, zero for PAD limbs on
+/// either side) and b. lo[k] sums the low halves of the products landing in column k, hi[k]
+/// the high halves, which belong one column up
+IFMA_TARGET void product_columns(uint64_t* lo, uint64_t* hi, const uint64_t* padded, size_t ma,
+								 const uint64_t* b, size_t mb, size_t columns) {
+	for(size_t k = 0; k < columns; k += BLOCK) {
+		__m512i lo0 = _mm512_setzero_si512(), lo1 = lo0, lo2 = lo0, lo3 = lo0;
+		__m512i hi0 = lo0, hi1 = lo0, hi2 = lo0, hi3 = lo0;
+
+		// every column of the block sees a[k' - j] * b[j] for j <= k' and k' - j < ma, the
+		// padding supplies zeros for the lanes outside that range
+		const size_t begin = k + 1 > ma ? k + 1 - ma : 0;
+		const size_t end = std::min(mb, k + BLOCK);
+		for(size_t j = begin; j < end; j++) {
+			const __m512i bj = _mm512_set1_epi64(b[j]);
+			const uint64_t* row = padded + PAD + k - j;
+			const __m512i a0 = _mm512_loadu_si512(row);
+			const __m512i a1 = _mm512_loadu_si512(row + LANES);
+			const __m512i a2 = _mm512_loadu_si512(row + 2 * LANES);
+			const __m512i a3 = _mm512_loadu_si512(row + 3 * LANES);
+			lo0 = _mm512_madd52lo_epu64(lo0, a0, bj);
+			lo1 = _mm512_madd52lo_epu64(lo1, a1, bj);
+			lo2 = _mm512_madd52lo_epu64(lo2, a2, bj);
+			lo3 = _mm512_madd52lo_epu64(lo3, a3, bj);
+			hi0 = _mm512_madd52hi_epu64(hi0, a0, bj);
+			hi1 = _mm512_madd52hi_epu64(hi1, a1, bj);
+			hi2 = _mm512_madd52hi_epu64(hi2, a2, bj);
+			hi3 = _mm512_madd52hi_epu64(hi3, a3, bj);
+		}
+
+		_mm512_store_si512(lo + k, lo0);
+		_mm512_store_si512(lo + k + LANES, lo1);
+		_mm512_store_si512(lo + k + 2 * LANES, lo2);
+		_mm512_store_si512(lo + k + 3 * LANES, lo3);
+		_mm512_store_si512(hi + k, hi0);
+		_mm512_store_si512(hi + k + LANES, hi1);
+		_mm512_store_si512(hi + k + 2 * LANES, hi2);
+		_mm512_store_si512(hi + k + 3 * LANES, hi3);
+	}
+}
+
+/// @brief t[0..size] = a * b / R mod N + (0 or N) in redundant form, limbs below 2^64.
+/// word by word montgomery: each step adds a * b[i] and q * N with q picked to clear the low
+/// limb, then shifts the lanes down one limb. the low halves of both products land before the
+/// shift and the high halves, one limb up, after it
+IFMA_TARGET void montgomery_lanes(uint64_t* t, const uint64_t* a, const uint64_t* b,
+								  const uint64_t* modulus, uint64_t inverse, size_t m,
+								  size_t size) {
+	constexpr size_t MAX_VECTORS = (limbs52(MAX_MONTGOMERY_LIMBS) + LANES - 1) / LANES;
+	const size_t vectors = size / LANES;
+	assert(vectors <= MAX_VECTORS);
+
+	__m512i acc[MAX_VECTORS];
+	for(size_t v = 0; v < vectors; v++) {
+		acc[v] = _mm512_setzero_si512();
+	}
+	const __m512i zero = _mm512_setzero_si512();
+
+	uint64_t t0 = 0; // lane 0, read back once per step
+	for(size_t i = 0; i < m; i++) {
+		const uint64_t bi = b[i];
+		const uint64_t q = ((t0 + a[0] * bi) * inverse) & MASK52;
+		const __m512i bv = _mm512_set1_epi64(bi);
+		const __m512i qv = _mm512_set1_epi64(q);
+
+		for(size_t v = 0; v < vectors; v++) {
+			const __m512i av = _mm512_loadu_si512(a + v * LANES);
+			const __m512i nv = _mm512_loadu_si512(modulus + v * LANES);
+			acc[v] = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(acc[v], av, bv), nv, qv);
+		}
+
+		// the low limb is now a multiple of 2^52, only its carry moves on
+		const uint64_t carry = (t0 + ((a[0] * bi) & MASK52) + ((modulus[0] * q) & MASK52)) >> 52;
+		for(size_t v = 0; v < vectors; v++) {
+			const __m512i av = _mm512_loadu_si512(a + v * LANES);
+			const __m512i nv = _mm512_loadu_si512(modulus + v * LANES);
+			const __m512i next = v + 1 < vectors ? acc[v + 1] : zero;
+			const __m512i shifted = _mm512_alignr_epi64(next, acc[v], 1);
+			acc[v] = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(shifted, av, bv), nv, qv);
+		}
+		acc[0] = _mm512_add_epi64(acc[0], _mm512_maskz_set1_epi64(1, carry));
+		t0 = _mm_cvtsi128_si64(_mm512_castsi512_si128(acc[0]));
+	}
+
+	for(size_t v = 0; v < vectors; v++) {
+		_mm512_storeu_si512(t + v * LANES, acc[v]);
+	}
+}
+
+} // namespace
+#endif
+
+void mul(uint64_t* out, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+	assert(supported() && bn > 0 && bn <= an && bn <= MAX_MUL_LIMBS);
+#if IFMA_KERNELS
+	const size_t ma = limbs52(an);
+	const size_t mb = limbs52(bn);
+	const size_t columns = (ma + mb + BLOCK - 1) / BLOCK * BLOCK;
+
+	Workspace::Frame frame(current_workspace());
+	uint64_t* padded = frame.take(PAD + ma + PAD);
+	uint64_t* b52 = frame.take(mb);
+	uint64_t* lo = frame.take(columns);
+	uint64_t* hi = frame.take(columns);
+
+	std::fill(padded, padded + PAD, 0);
+	pack52(padded + PAD, ma, a, an);
+	std::fill(padded + PAD + ma, padded + PAD + ma + PAD, 0);
+	pack52(b52, mb, b, bn);
+
+	product_columns(lo, hi, padded, ma, b52, mb, columns);
+
+	// each column is the low halves of its products plus the high halves from one column down
+	for(size_t k = ma + mb - 1; k > 0; k--) {
+		lo[k] += hi[k - 1];
+	}
+	normalize52(lo, ma + mb);
+	unpack52(out, an + bn, lo, ma + mb);
+#else
+	(void)out, (void)a, (void)an, (void)b, (void)bn;
+#endif
+}
+
+// ============================================================================
+// Section: montgomery
+// ============================================================================
+Montgomery::Montgomery(const uint64_t* modulus, const uint64_t* r2, size_t n)
+	: m_limbs(limbs52(n))
+	, m_size(vector_limbs(m_limbs)) {
+	assert(supported() && (modulus[0] & 1) && n <= MAX_MONTGOMERY_LIMBS);
+	m_modulus.resize(m_size);
+	pack52(m_modulus.data(), m_size, modulus, n);
+	m_r2.resize(m_size);
+	pack52(m_r2.data(), m_size, r2, n);
+
+	// newton iteration for N^-1 mod 2^64, the low 52 bits are the inverse mod 2^52
+	const uint64_t n0 = modulus[0];
+	uint64_t inverse = n0;
+	for(int i = 0; i < 5; i++) {
+		inverse *= 2 - n0 * inverse;
+	}
+	m_inverse = -inverse & MASK52;
+}
+
+size_t Montgomery::size() const noexcept {
+	return m_size;
+}
+
+void Montgomery::mul(uint64_t* out, const uint64_t* a, const uint64_t* b) const {
+#if IFMA_KERNELS
+	Workspace::Frame frame(current_workspace());
+	uint64_t* t = frame.take(2 * m_size);
+	montgomery_lanes(t, a, b, m_modulus.data(), m_inverse, m_limbs, m_size);
+
+	// the lanes hold a value below 2N < 2R, so at most one bit carries out of the m limbs
+	const uint64_t top = normalize52(t, m_limbs);
+	reduce_once(t, top, m_modulus.data(), m_limbs);
+	std::copy(t, t + m_limbs, out);
+	std::fill(out + m_limbs, out + m_size, 0);
+#else
+	(void)out, (void)a, (void)b;
+#endif
+}
+
+void Montgomery::to_mont(uint64_t* out, const uint64_t* x, size_t n) const {
+	Workspace::Frame frame(current_workspace());
+	uint64_t* plain = frame.take(m_size);
+	pack52(plain, m_size, x, n);
+	mul(out, plain, m_r2.data());
+}
+
+void Montgomery::from_mont(uint64_t* out, size_t n, const uint64_t* x) const {
+	Workspace::Frame frame(current_workspace());
+	uint64_t* one = frame.take(m_size);
+	std::fill(one, one + m_size, 0);
+	one[0] = 1;
+	uint64_t* plain = frame.take(m_size);
+	mul(plain, x, one);
+	unpack52(out, n, plain, m_limbs);
+}
+
+} // namespace ifma
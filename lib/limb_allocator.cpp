@@ -0,0 +1,174 @@
+#include "include/limb_allocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+// ============================================================================
+// Section: thread caches
+// ============================================================================
+namespace {
+
+constexpr size_t SIZE_CLASSES = 11; // 64 B up to 64 KiB
+static_assert((LimbPool::MIN_BLOCK << (SIZE_CLASSES - 1)) == LimbPool::MAX_BLOCK);
+
+struct FreeBlock {
+	FreeBlock* next;
+};
+
+/// @brief trivially destructible so that blocks freed during thread or program teardown, after
+/// the guard below has drained it, can still check the drained flag
+struct ThreadCache {
+	FreeBlock* heads[SIZE_CLASSES];
+	size_t counts[SIZE_CLASSES];
+	bool drained;
+};
+
+thread_local ThreadCache cache{};
+
+struct ThreadCacheGuard {
+	~ThreadCacheGuard() {
+		LimbPool::trim();
+		cache.drained = true;
+	}
+};
+
+thread_local ThreadCacheGuard guard;
+
+thread_local LimbResource* current_resource = nullptr;
+
+void* aligned_block(size_t bytes) {
+	void* ptr = std::aligned_alloc(64, bytes);
+	if(!ptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+/// @brief index of the smallest class holding bytes, for 0 < bytes <= MAX_BLOCK
+size_t size_class(size_t bytes) noexcept {
+	const size_t lines = (bytes - 1) / LimbPool::MIN_BLOCK;
+	return lines ? 64 - __builtin_clzll(lines) : 0;
+}
+
+} // namespace
+
+// ============================================================================
+// Section: pool
+// ============================================================================
+void* LimbPool::allocate(size_t bytes) {
+	if(bytes > MAX_BLOCK) {
+		return aligned_block(bytes);
+	}
+
+	// blocks always get their full class size since any thread may recycle them later
+	const size_t cls = size_class(bytes);
+	FreeBlock* head = cache.heads[cls];
+	if(head) {
+		cache.heads[cls] = head->next;
+		cache.counts[cls]--;
+		return head;
+	}
+	return aligned_block(MIN_BLOCK << cls);
+}
+
+void LimbPool::deallocate(void* ptr, size_t bytes) noexcept {
+	if(bytes > MAX_BLOCK) {
+		std::free(ptr);
+		return;
+	}
+
+	const size_t cls = size_class(bytes);
+	if(cache.drained || cache.counts[cls] >= MAX_CACHED_BLOCKS) {
+		std::free(ptr);
+		return;
+	}
+
+	// the first cached block registers the guard that drains the cache at thread exit
+	static_cast<void>(&guard);
+
+	FreeBlock* block = static_cast<FreeBlock*>(ptr);
+	block->next = cache.heads[cls];
+	cache.heads[cls] = block;
+	cache.counts[cls]++;
+}
+
+void LimbPool::trim() noexcept {
+	for(size_t cls = 0; cls < SIZE_CLASSES; cls++) {
+		while(cache.heads[cls]) {
+			FreeBlock* block = cache.heads[cls];
+			cache.heads[cls] = block->next;
+			std::free(block);
+		}
+		cache.counts[cls] = 0;
+	}
+}
+
+LimbPool& LimbPool::instance() noexcept {
+	// never destroyed, values with static storage may still release blocks at exit
+	static LimbPool& pool = *new LimbPool();
+	return pool;
+}
+
+// ============================================================================
+// Section: arena
+// ============================================================================
+LimbArena::~LimbArena() {
+	release();
+}
+
+void* LimbArena::allocate(size_t bytes) {
+	if(static_cast<size_t>(m_end - m_cursor) < bytes) {
+		const size_t previous = m_chunks.empty() ? 0 : m_chunks.back().size;
+		const size_t size = std::max({ bytes, MIN_CHUNK, 2 * previous });
+		char* data = static_cast<char*>(aligned_block(size));
+		m_chunks.push_back({ data, size });
+		m_cursor = data;
+		m_end = data + size;
+	}
+
+	m_last = m_cursor;
+	m_cursor += bytes;
+	m_used += bytes;
+	return m_last;
+}
+
+void LimbArena::deallocate(void* ptr, size_t bytes) noexcept {
+	// temporaries mostly die in reverse order, so the latest block can be handed back
+	if(ptr == m_last && m_last + bytes == m_cursor) {
+		m_cursor = m_last;
+		m_last = nullptr;
+		m_used -= bytes;
+	}
+}
+
+void LimbArena::release() noexcept {
+	for(const Chunk& chunk : m_chunks) {
+		std::free(chunk.data);
+	}
+	m_chunks.clear();
+	m_cursor = nullptr;
+	m_end = nullptr;
+	m_last = nullptr;
+	m_used = 0;
+}
+
+size_t LimbArena::bytes_used() const noexcept {
+	return m_used;
+}
+
+// ============================================================================
+// Section: scopes
+// ============================================================================
+ArenaScope::ArenaScope(LimbArena& arena) noexcept
+	: m_previous(current_resource) {
+	current_resource = &arena;
+}
+
+ArenaScope::~ArenaScope() {
+	current_resource = m_previous;
+}
+
+LimbResource* current_limb_resource() noexcept {
+	return current_resource ? current_resource : &LimbPool::instance();
+}
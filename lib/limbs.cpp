@@ -0,0 +1,318 @@
+#include "include/limbs.hpp"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+namespace limbs {
+
+Kernels kernels = {
+	portable::add_n, portable::sub_n, portable::mul_1, portable::addmul_1, portable::submul_1,
+	"portable",
+};
+
+} // namespace limbs
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+// ============================================================================
+// Section: x86-64 kernels
+// ============================================================================
+// every loop handles the n % 4 leftover limbs one at a time and then runs four limbs per
+// iteration. inc, dec and lea leave the carry flag alone, so the carry stays in CF across the
+// whole span instead of round tripping through a register
+namespace {
+
+using limbs::limb_t;
+
+limb_t add_n_x86(limb_t* out, const limb_t* a, const limb_t* b, size_t n) {
+	limb_t blocks = n >> 2;
+	limb_t carry;
+	n &= 3;
+	asm volatile("xorl %k[carry], %k[carry]\n\t" // clears CF
+				 "jrcxz 2f\n"
+				 "1:\n\t"
+				 "movq (%[a]), %%r8\n\t"
+				 "adcq (%[b]), %%r8\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "leaq 8(%[a]), %[a]\n\t"
+				 "leaq 8(%[b]), %[b]\n\t"
+				 "leaq 8(%[out]), %[out]\n\t"
+				 "decq %%rcx\n\t"
+				 "jnz 1b\n"
+				 "2:\n\t"
+				 "movq %[blocks], %%rcx\n\t"
+				 "jrcxz 4f\n"
+				 "3:\n\t"
+				 "movq (%[a]), %%r8\n\t"
+				 "movq 8(%[a]), %%r9\n\t"
+				 "movq 16(%[a]), %%r10\n\t"
+				 "movq 24(%[a]), %%r11\n\t"
+				 "adcq (%[b]), %%r8\n\t"
+				 "adcq 8(%[b]), %%r9\n\t"
+				 "adcq 16(%[b]), %%r10\n\t"
+				 "adcq 24(%[b]), %%r11\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "movq %%r9, 8(%[out])\n\t"
+				 "movq %%r10, 16(%[out])\n\t"
+				 "movq %%r11, 24(%[out])\n\t"
+				 "leaq 32(%[a]), %[a]\n\t"
+				 "leaq 32(%[b]), %[b]\n\t"
+				 "leaq 32(%[out]), %[out]\n\t"
+				 "decq %%rcx\n\t"
+				 "jnz 3b\n"
+				 "4:\n\t"
+				 "adcl $0, %k[carry]"
+				 : [out] "+r"(out), [a] "+r"(a), [b] "+r"(b), "+c"(n), [carry] "=&r"(carry)
+				 : [blocks] "r"(blocks)
+				 : "r8", "r9", "r10", "r11", "cc", "memory");
+	return carry;
+}
+
+limb_t sub_n_x86(limb_t* out, const limb_t* a, const limb_t* b, size_t n) {
+	limb_t blocks = n >> 2;
+	limb_t borrow;
+	n &= 3;
+	asm volatile("xorl %k[borrow], %k[borrow]\n\t"
+				 "jrcxz 2f\n"
+				 "1:\n\t"
+				 "movq (%[a]), %%r8\n\t"
+				 "sbbq (%[b]), %%r8\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "leaq 8(%[a]), %[a]\n\t"
+				 "leaq 8(%[b]), %[b]\n\t"
+				 "leaq 8(%[out]), %[out]\n\t"
+				 "decq %%rcx\n\t"
+				 "jnz 1b\n"
+				 "2:\n\t"
+				 "movq %[blocks], %%rcx\n\t"
+				 "jrcxz 4f\n"
+				 "3:\n\t"
+				 "movq (%[a]), %%r8\n\t"
+				 "movq 8(%[a]), %%r9\n\t"
+				 "movq 16(%[a]), %%r10\n\t"
+				 "movq 24(%[a]), %%r11\n\t"
+				 "sbbq (%[b]), %%r8\n\t"
+				 "sbbq 8(%[b]), %%r9\n\t"
+				 "sbbq 16(%[b]), %%r10\n\t"
+				 "sbbq 24(%[b]), %%r11\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "movq %%r9, 8(%[out])\n\t"
+				 "movq %%r10, 16(%[out])\n\t"
+				 "movq %%r11, 24(%[out])\n\t"
+				 "leaq 32(%[a]), %[a]\n\t"
+				 "leaq 32(%[b]), %[b]\n\t"
+				 "leaq 32(%[out]), %[out]\n\t"
+				 "decq %%rcx\n\t"
+				 "jnz 3b\n"
+				 "4:\n\t"
+				 "adcl $0, %k[borrow]"
+				 : [out] "+r"(out), [a] "+r"(a), [b] "+r"(b), "+c"(n), [borrow] "=&r"(borrow)
+				 : [blocks] "r"(blocks)
+				 : "r8", "r9", "r10", "r11", "cc", "memory");
+	return borrow;
+}
+
+// the multiply kernels keep the factor in rdx for MULX, which leaves the flags untouched, so
+// the adds can chain through them
+
+limb_t mul_1_mulx(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	limb_t blocks = n >> 2;
+	limb_t carry;
+	n &= 3;
+	asm volatile("xorl %k[carry], %k[carry]\n\t"
+				 "jrcxz 2f\n"
+				 "1:\n\t"
+				 "mulxq (%[a]), %%r8, %%r9\n\t"
+				 "adcq %[carry], %%r8\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "movq %%r9, %[carry]\n\t"
+				 "leaq 8(%[a]), %[a]\n\t"
+				 "leaq 8(%[out]), %[out]\n\t"
+				 "decq %%rcx\n\t"
+				 "jnz 1b\n"
+				 "2:\n\t"
+				 "movq %[blocks], %%rcx\n\t"
+				 "jrcxz 4f\n"
+				 "3:\n\t"
+				 "mulxq (%[a]), %%r8, %%r9\n\t"
+				 "adcq %[carry], %%r8\n\t"
+				 "mulxq 8(%[a]), %%r10, %[carry]\n\t"
+				 "adcq %%r9, %%r10\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "movq %%r10, 8(%[out])\n\t"
+				 "mulxq 16(%[a]), %%r8, %%r9\n\t"
+				 "adcq %[carry], %%r8\n\t"
+				 "mulxq 24(%[a]), %%r10, %[carry]\n\t"
+				 "adcq %%r9, %%r10\n\t"
+				 "movq %%r8, 16(%[out])\n\t"
+				 "movq %%r10, 24(%[out])\n\t"
+				 "leaq 32(%[a]), %[a]\n\t"
+				 "leaq 32(%[out]), %[out]\n\t"
+				 "decq %%rcx\n\t"
+				 "jnz 3b\n"
+				 "4:\n\t"
+				 "adcq $0, %[carry]"
+				 : [out] "+r"(out), [a] "+r"(a), "+c"(n), [carry] "=&r"(carry)
+				 : "d"(b), [blocks] "r"(blocks)
+				 : "r8", "r9", "r10", "cc", "memory");
+	return carry;
+}
+
+// addmul_1 and submul_1 run two independent carry chains, ADCX adding the previous high limb
+// into the low one through CF and ADOX folding in out[i] through OF. dec would clobber OF, so
+// the loops count down with lea and test the counter with jrcxz at the bottom, entered through
+// a jump since its 8 bit displacement cannot skip a whole unrolled body
+
+limb_t addmul_1_adx(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	limb_t blocks = n >> 2;
+	limb_t carry;
+	n &= 3;
+	asm volatile("xorl %k[carry], %k[carry]\n\t" // clears CF and OF
+				 "jmp 2f\n"
+				 "1:\n\t"
+				 "mulxq (%[a]), %%r8, %%r9\n\t"
+				 "adcxq %[carry], %%r8\n\t"
+				 "adoxq (%[out]), %%r8\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "movq %%r9, %[carry]\n\t"
+				 "leaq 8(%[a]), %[a]\n\t"
+				 "leaq 8(%[out]), %[out]\n\t"
+				 "leaq -1(%%rcx), %%rcx\n"
+				 "2:\n\t"
+				 "jrcxz 3f\n\t"
+				 "jmp 1b\n"
+				 "3:\n\t"
+				 "movq %[blocks], %%rcx\n\t"
+				 "jmp 5f\n"
+				 "4:\n\t"
+				 "mulxq (%[a]), %%r8, %%r9\n\t"
+				 "adcxq %[carry], %%r8\n\t"
+				 "adoxq (%[out]), %%r8\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "mulxq 8(%[a]), %%r8, %[carry]\n\t"
+				 "adcxq %%r9, %%r8\n\t"
+				 "adoxq 8(%[out]), %%r8\n\t"
+				 "movq %%r8, 8(%[out])\n\t"
+				 "mulxq 16(%[a]), %%r8, %%r9\n\t"
+				 "adcxq %[carry], %%r8\n\t"
+				 "adoxq 16(%[out]), %%r8\n\t"
+				 "movq %%r8, 16(%[out])\n\t"
+				 "mulxq 24(%[a]), %%r8, %[carry]\n\t"
+				 "adcxq %%r9, %%r8\n\t"
+				 "adoxq 24(%[out]), %%r8\n\t"
+				 "movq %%r8, 24(%[out])\n\t"
+				 "leaq 32(%[a]), %[a]\n\t"
+				 "leaq 32(%[out]), %[out]\n\t"
+				 "leaq -1(%%rcx), %%rcx\n"
+				 "5:\n\t"
+				 "jrcxz 6f\n\t"
+				 "jmp 4b\n"
+				 "6:\n\t"
+				 "movl $0, %%r8d\n\t"
+				 "adcxq %%r8, %[carry]\n\t"
+				 "adoxq %%r8, %[carry]"
+				 : [out] "+r"(out), [a] "+r"(a), "+c"(n), [carry] "=&r"(carry)
+				 : "d"(b), [blocks] "r"(blocks)
+				 : "r8", "r9", "cc", "memory");
+	return carry;
+}
+
+// subtracting goes through the complement, out - x == ~(~out + x), so OF carries the borrow of
+// the subtraction and the returned high limb plus both flags is the borrow limb
+
+limb_t submul_1_adx(limb_t* out, const limb_t* a, size_t n, limb_t b) {
+	limb_t blocks = n >> 2;
+	limb_t borrow;
+	n &= 3;
+	asm volatile("xorl %k[borrow], %k[borrow]\n\t"
+				 "jmp 2f\n"
+				 "1:\n\t"
+				 "mulxq (%[a]), %%r8, %%r9\n\t"
+				 "adcxq %[borrow], %%r8\n\t"
+				 "movq (%[out]), %%r10\n\t"
+				 "notq %%r10\n\t"
+				 "adoxq %%r10, %%r8\n\t"
+				 "notq %%r8\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "movq %%r9, %[borrow]\n\t"
+				 "leaq 8(%[a]), %[a]\n\t"
+				 "leaq 8(%[out]), %[out]\n\t"
+				 "leaq -1(%%rcx), %%rcx\n"
+				 "2:\n\t"
+				 "jrcxz 3f\n\t"
+				 "jmp 1b\n"
+				 "3:\n\t"
+				 "movq %[blocks], %%rcx\n\t"
+				 "jmp 5f\n"
+				 "4:\n\t"
+				 "mulxq (%[a]), %%r8, %%r9\n\t"
+				 "adcxq %[borrow], %%r8\n\t"
+				 "movq (%[out]), %%r10\n\t"
+				 "notq %%r10\n\t"
+				 "adoxq %%r10, %%r8\n\t"
+				 "notq %%r8\n\t"
+				 "movq %%r8, (%[out])\n\t"
+				 "mulxq 8(%[a]), %%r8, %[borrow]\n\t"
+				 "adcxq %%r9, %%r8\n\t"
+				 "movq 8(%[out]), %%r10\n\t"
+				 "notq %%r10\n\t"
+				 "adoxq %%r10, %%r8\n\t"
+				 "notq %%r8\n\t"
+				 "movq %%r8, 8(%[out])\n\t"
+				 "mulxq 16(%[a]), %%r8, %%r9\n\t"
+				 "adcxq %[borrow], %%r8\n\t"
+				 "movq 16(%[out]), %%r10\n\t"
+				 "notq %%r10\n\t"
+				 "adoxq %%r10, %%r8\n\t"
+				 "notq %%r8\n\t"
+				 "movq %%r8, 16(%[out])\n\t"
+				 "mulxq 24(%[a]), %%r8, %[borrow]\n\t"
+				 "adcxq %%r9, %%r8\n\t"
+				 "movq 24(%[out]), %%r10\n\t"
+				 "notq %%r10\n\t"
+				 "adoxq %%r10, %%r8\n\t"
+				 "notq %%r8\n\t"
+				 "movq %%r8, 24(%[out])\n\t"
+				 "leaq 32(%[a]), %[a]\n\t"
+				 "leaq 32(%[out]), %[out]\n\t"
+				 "leaq -1(%%rcx), %%rcx\n"
+				 "5:\n\t"
+				 "jrcxz 6f\n\t"
+				 "jmp 4b\n"
+				 "6:\n\t"
+				 "movl $0, %%r8d\n\t"
+				 "adcxq %%r8, %[borrow]\n\t"
+				 "adoxq %%r8, %[borrow]"
+				 : [out] "+r"(out), [a] "+r"(a), "+c"(n), [borrow] "=&r"(borrow)
+				 : "d"(b), [blocks] "r"(blocks)
+				 : "r8", "r9", "r10", "cc", "memory");
+	return borrow;
+}
+
+bool has_mulx_adx() {
+	unsigned eax, ebx, ecx, edx;
+	if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		return false;
+	}
+	return (ebx & bit_BMI2) && (ebx & bit_ADX);
+}
+
+/// @brief swaps in the fastest kernels the cpu runs. add_n and sub_n only need base x86-64,
+/// the multiply kernels need BMI2 for MULX and ADX for the dual carry chains
+const bool kernels_selected = [] {
+	limbs::kernels.add_n = add_n_x86;
+	limbs::kernels.sub_n = sub_n_x86;
+	limbs::kernels.name = "x86-64";
+	if(has_mulx_adx()) {
+		limbs::kernels.mul_1 = mul_1_mulx;
+		limbs::kernels.addmul_1 = addmul_1_adx;
+		limbs::kernels.submul_1 = submul_1_adx;
+		limbs::kernels.name = "x86-64 mulx/adx";
+	}
+	return true;
+}();
+
+} // namespace
+
+#endif
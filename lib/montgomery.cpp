@@ -0,0 +1,238 @@
+#include "include/montgomery.hpp"
+#include "include/limbs.hpp"
+#include "include/sliding_window.tpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+using namespace limbs;
+
+// ============================================================================
+// Section: setup
+// ============================================================================
+MontgomeryContext::MontgomeryContext(const UnsignedBigInt& modulus)
+	: m_modulus(modulus)
+	, m_size(modulus.m_digits)
+	, m_inverse(0) {
+	if((modulus.m_container[0] & 1) == 0) {
+		throw BigNumEvenModulusException();
+	}
+
+	// newton iteration for N^-1 mod 2^64, each step doubles the number of correct bits
+	const base_t n0 = modulus.m_container[0];
+	base_t inverse = n0;
+	for(int i = 0; i < 5; i++) {
+		inverse *= 2 - n0 * inverse;
+	}
+	m_inverse = -inverse;
+
+	m_r2.resize(m_size);
+	load(m_r2.data(), UnsignedBigInt(1) << (128 * m_size));
+
+	if(ifma::supported() && m_size >= IFMA_THRESHOLD && m_size <= ifma::MAX_MONTGOMERY_LIMBS) {
+		// the radix 2^52 form has its own R = 2^(52m)
+		container r2;
+		r2.resize(m_size);
+		load(r2.data(), UnsignedBigInt(1) << (104 * ifma::limbs52(m_size)));
+		m_ifma = ifma::Montgomery(modulus.m_container.data(), r2.data(), m_size);
+	}
+}
+
+const UnsignedBigInt& MontgomeryContext::modulus() const noexcept {
+	return m_modulus;
+}
+
+void MontgomeryContext::load(base_t* out, const UnsignedBigInt& x) const {
+	if(x >= m_modulus) {
+		load(out, x % m_modulus);
+		return;
+	}
+	std::fill(std::copy(x.m_container.begin(), x.m_container.begin() + x.m_digits, out),
+			  out + m_size,
+			  0);
+}
+
+size_t MontgomeryContext::scratch_size() const noexcept {
+	return 2 * m_size + 2 + UnsignedBigInt::mul_n_scratch_size(m_size);
+}
+
+// ============================================================================
+// Section: limb kernels
+// ============================================================================
+void MontgomeryContext::mont_mul(
+	base_t* out, const base_t* a, const base_t* b, base_t* scratch) const {
+	const size_t n = m_size;
+	const base_t* modulus = m_modulus.m_container.data();
+	base_t* t = scratch;
+	std::fill(t, t + 2 * n + 1, 0);
+
+	// row i works on the window t[i..i+n], whose top limb holds what the previous row carried
+	// out. each row clears the window's low limb, so the result slides up one limb per row
+	for(size_t i = 0; i < n; i++) {
+		base_t* window = t + i;
+		// window += a * b[i]
+		const base_t product_carry = addmul_1(window, a, n, b[i]);
+		const base_t top = window[n] + product_carry;
+		base_t overflow = top < product_carry;
+
+		// window += m * N, with m chosen so the low limb cancels
+		const base_t reduce_carry = addmul_1(window, modulus, n, window[0] * m_inverse);
+		window[n] = top + reduce_carry;
+		overflow += window[n] < reduce_carry;
+		window[n + 1] = overflow;
+	}
+
+	// t < 2N, one conditional subtraction brings it below N
+	if(t[2 * n] || compare(t + n, n, modulus, n) >= 0) {
+		sub(out, t + n, n, modulus, n);
+	} else {
+		std::copy(t + n, t + 2 * n, out);
+	}
+}
+
+void MontgomeryContext::mont_sqr(base_t* out, const base_t* a, base_t* scratch) const {
+	const size_t n = m_size;
+	const base_t* modulus = m_modulus.m_container.data();
+	base_t* t = scratch;
+	UnsignedBigInt::sqr_n(t, a, n, scratch + 2 * n + 2);
+
+	// separated reduction: clear one low limb of the square per step
+	base_t top = 0;
+	for(size_t i = 0; i < n; i++) {
+		const base_t carry = addmul_1(t + i, modulus, n, t[i] * m_inverse);
+		top += add(t + i + n, t + i + n, n - i, &carry, 1);
+	}
+
+	if(top || compare(t + n, n, modulus, n) >= 0) {
+		sub(out, t + n, n, modulus, n);
+	} else {
+		std::copy(t + n, t + 2 * n, out);
+	}
+}
+
+// ============================================================================
+// Section: arithmetic
+// ============================================================================
+UnsignedBigInt MontgomeryContext::to_mont(const UnsignedBigInt& x) const {
+	Workspace::Frame frame(current_workspace());
+	base_t* a = frame.take(m_size);
+	load(a, x);
+
+	UnsignedBigInt ret;
+	ret.m_container.resize(m_size);
+	mont_mul(ret.m_container.data(), a, m_r2.data(), frame.take(scratch_size()));
+	ret.m_digits = m_size;
+	ret.normalize();
+	return ret;
+}
+
+UnsignedBigInt MontgomeryContext::from_mont(const UnsignedBigInt& x) const {
+	Workspace::Frame frame(current_workspace());
+	base_t* a = frame.take(m_size);
+	load(a, x);
+	base_t* one = frame.take(m_size);
+	std::fill(one, one + m_size, 0);
+	one[0] = 1;
+
+	UnsignedBigInt ret;
+	ret.m_container.resize(m_size);
+	mont_mul(ret.m_container.data(), a, one, frame.take(scratch_size()));
+	ret.m_digits = m_size;
+	ret.normalize();
+	return ret;
+}
+
+UnsignedBigInt MontgomeryContext::mul(const UnsignedBigInt& a, const UnsignedBigInt& b) const {
+	assert(a < m_modulus && b < m_modulus);
+	Workspace::Frame frame(current_workspace());
+	base_t* x = frame.take(m_size);
+	base_t* y = frame.take(m_size);
+	load(x, a);
+	load(y, b);
+
+	UnsignedBigInt ret;
+	ret.m_container.resize(m_size);
+	mont_mul(ret.m_container.data(), x, y, frame.take(scratch_size()));
+	ret.m_digits = m_size;
+	ret.normalize();
+	return ret;
+}
+
+UnsignedBigInt MontgomeryContext::sqr(const UnsignedBigInt& a) const {
+	assert(a < m_modulus);
+	Workspace::Frame frame(current_workspace());
+	base_t* x = frame.take(m_size);
+	load(x, a);
+
+	UnsignedBigInt ret;
+	ret.m_container.resize(m_size);
+	mont_sqr(ret.m_container.data(), x, frame.take(scratch_size()));
+	ret.m_digits = m_size;
+	ret.normalize();
+	return ret;
+}
+
+UnsignedBigInt MontgomeryContext::pow(const UnsignedBigInt& base, const UnsignedBigInt& exp) const {
+	if(exp == UnsignedBigInt(0)) {
+		return UnsignedBigInt(1) % m_modulus;
+	}
+	if(m_ifma.size() && ifma::enabled()) {
+		return pow_ifma(base, exp);
+	}
+
+	// the whole exponentiation runs on workspace limbs sharing one scratch area, converting in
+	// and out of montgomery form on the limbs as well
+	const size_t n = m_size;
+	Workspace::Frame frame(current_workspace());
+	base_t* scratch = frame.take(scratch_size());
+	base_t* plain = frame.take(n);
+	base_t* x = frame.take(n);
+	base_t* result = frame.take(n);
+
+	load(plain, base);
+	mont_mul(x, plain, m_r2.data(), scratch);
+	sliding_window::pow(
+		result,
+		x,
+		n,
+		exp,
+		[&](base_t* out, const base_t* a, const base_t* b) { mont_mul(out, a, b, scratch); },
+		[&](base_t* out, const base_t* a) { mont_sqr(out, a, scratch); });
+
+	std::fill(plain, plain + n, 0);
+	plain[0] = 1;
+	UnsignedBigInt ret;
+	ret.m_container.resize(n);
+	mont_mul(ret.m_container.data(), result, plain, scratch);
+	ret.m_digits = n;
+	ret.normalize();
+	return ret;
+}
+
+UnsignedBigInt MontgomeryContext::pow_ifma(
+	const UnsignedBigInt& base, const UnsignedBigInt& exp) const {
+	const size_t size = m_ifma.size();
+	Workspace::Frame frame(current_workspace());
+	base_t* plain = frame.take(m_size);
+	base_t* x = frame.take(size);
+	base_t* result = frame.take(size);
+
+	load(plain, base);
+	m_ifma.to_mont(x, plain, m_size);
+	sliding_window::pow(
+		result,
+		x,
+		size,
+		exp,
+		[&](base_t* out, const base_t* a, const base_t* b) { m_ifma.mul(out, a, b); },
+		[&](base_t* out, const base_t* a) { m_ifma.mul(out, a, a); });
+
+	UnsignedBigInt ret;
+	ret.m_container.resize(m_size);
+	m_ifma.from_mont(ret.m_container.data(), m_size, result);
+	ret.m_digits = m_size;
+	ret.normalize();
+	return ret;
+}
@@ -0,0 +1,631 @@
+#include "include/bignum.hpp"
+#include "include/ifma.hpp"
+#include "include/limbs.hpp"
+#include "include/thread_pool.hpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+using namespace limbs;
+
+// ============================================================================
+// Section: toom helpers
+// ============================================================================
+namespace {
+
+/// @brief exact division by 3 of an n limb value, computed modulo B^n by multiplying with the
+/// inverse of 3. also correct for two's complement negative values
+inline void divexact_by3(limb_t* x, size_t n) {
+	static constexpr limb_t INVERSE_3 = 0xAAAAAAAAAAAAAAABull;
+	limb_t carry = 0;
+	for(size_t i = 0; i < n; i++) {
+		const limb_t limb = x[i];
+		const limb_t diff = limb - carry;
+		carry = diff > limb;
+
+		const limb_t q = diff * INVERSE_3;
+		x[i] = q;
+		// high limb of 3 * q
+		carry += (q > 0x5555555555555555ull) + (q > 0xAAAAAAAAAAAAAAAAull);
+	}
+}
+
+/// @brief exact division by an odd single limb divisor, modulo B^n
+inline void divexact_1(limb_t* x, size_t n, limb_t d) {
+	assert(d & 1);
+	// newton iteration for the inverse of d modulo 2^64, each step doubles the correct bits
+	limb_t inverse = d;
+	for(int i = 0; i < 5; i++) {
+		inverse *= 2 - d * inverse;
+	}
+
+	limb_t carry = 0;
+	for(size_t i = 0; i < n; i++) {
+		const limb_t limb = x[i];
+		const limb_t diff = limb - carry;
+		carry = diff > limb;
+
+		const limb_t q = diff * inverse;
+		x[i] = q;
+		carry += static_cast<limb_t>((static_cast<__uint128_t>(q) * d) >> 64);
+	}
+}
+
+// toom interpolation runs on fixed width two's complement values of L limbs. every
+// intermediate fits in L - 1 limbs so overflow never reaches the sign limb.
+
+inline void tc_add(limb_t* out, const limb_t* a, const limb_t* b, size_t L) {
+	add_n(out, a, b, L);
+}
+
+inline void tc_sub(limb_t* out, const limb_t* a, const limb_t* b, size_t L) {
+	sub_n(out, a, b, L);
+}
+
+/// @brief arithmetic (sign preserving) right shift, 0 < shift < 64
+inline void tc_shr(limb_t* x, size_t L, unsigned shift) {
+	for(size_t i = 0; i + 1 < L; i++) {
+		x[i] = (x[i] >> shift) | (x[i + 1] << (64 - shift));
+	}
+	x[L - 1] = static_cast<limb_t>(static_cast<int64_t>(x[L - 1]) >> shift);
+}
+
+inline void tc_negate(limb_t* x, size_t L) {
+	limb_t carry = 1;
+	for(size_t i = 0; i < L; i++) {
+		const limb_t inverted = ~x[i];
+		x[i] = inverted + carry;
+		carry = x[i] < carry;
+	}
+}
+
+/// @brief dst[0..L] = src[0..n] zero extended
+inline void tc_extend(limb_t* dst, const limb_t* src, size_t n, size_t L) {
+	std::copy(src, src + n, dst);
+	std::fill(dst + n, dst + L, 0);
+}
+
+/// @brief x -= y << shift, using tmp as an L limb temporary
+inline void tc_sub_shifted(limb_t* x, const limb_t* y, unsigned shift, limb_t* tmp, size_t L) {
+	lshift(tmp, y, L, shift);
+	tc_sub(x, x, tmp, L);
+}
+
+/// @brief out[offset..n] += src, where src may carry leading zero limbs
+inline void add_into(limb_t* out, size_t n, size_t offset, const limb_t* src, size_t len) {
+	while(len > 0 && src[len - 1] == 0) {
+		len--;
+	}
+	assert(offset + len <= n);
+
+	[[maybe_unused]] const limb_t carry = add(out + offset, out + offset, n - offset, src, len);
+	assert(carry == 0);
+}
+
+} // namespace
+
+// ============================================================================
+// Section: limb kernels
+// ============================================================================
+void UnsignedBigInt::mul_schoolbook(
+	base_t* out, const base_t* a, size_t an, const base_t* b, size_t bn) {
+	out[an] = mul_1(out, a, an, b[0]);
+	for(size_t i = 1; i < bn; i++) {
+		out[an + i] = addmul_1(out + i, a, an, b[i]);
+	}
+}
+
+void UnsignedBigInt::mul_karatsuba(base_t* out, const base_t* a, const base_t* b, size_t n,
+								   base_t* scratch) {
+	assert(n >= 2);
+
+	// a = a1 * B^lo + a0 where a0 has lo limbs and a1 has hi <= lo limbs
+	const size_t lo = (n + 1) / 2;
+	const size_t hi = n - lo;
+
+	// scratch layout: [t: 2lo][m: 2lo + 1][recursion...]
+	// the differences |a0 - a1| and |b0 - b1| live in m until the middle term is formed
+	base_t* t = scratch;
+	base_t* m = scratch + 2 * lo;
+	base_t* rest = m + 2 * lo + 1;
+
+	base_t* da = m;
+	base_t* db = m + lo;
+	const bool a_negative = abs_diff(da, a, lo, a + lo, hi);
+	const bool b_negative = abs_diff(db, b, lo, b + lo, hi);
+
+	const Subproduct products[] = {
+		{ t, da, db, lo },
+		{ out, a, b, lo },
+		{ out + 2 * lo, a + lo, b + lo, hi },
+	};
+	mul_subproducts(products, 3, n, rest);
+
+	// middle term: a0*b1 + a1*b0 = a0*b0 + a1*b1 - (a0 - a1)(b0 - b1)
+	m[2 * lo] = add(m, out, 2 * lo, out + 2 * lo, 2 * hi);
+	if(a_negative == b_negative) {
+		sub(m, m, 2 * lo + 1, t, 2 * lo);
+	} else {
+		add(m, m, 2 * lo + 1, t, 2 * lo);
+	}
+
+	add_into(out, 2 * n, lo, m, 2 * lo + 1);
+}
+
+// ----------------------------------------------------------------------------
+// squaring
+// ----------------------------------------------------------------------------
+void UnsignedBigInt::sqr_schoolbook(base_t* out, const base_t* a, size_t n) {
+	// off diagonal products a_i * a_j for i < j, row i starts at limb 2i + 1
+	out[0] = 0;
+	out[n] = mul_1(out + 1, a + 1, n - 1, a[0]);
+	for(size_t i = 1; i + 1 < n; i++) {
+		out[n + i] = addmul_1(out + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+	}
+	out[2 * n - 1] = 0;
+
+	// double them and add the diagonal a_i^2
+	lshift(out, out, 2 * n, 1);
+	unsigned char carry = 0;
+	for(size_t i = 0; i < n; i++) {
+		const __uint128_t square = static_cast<__uint128_t>(a[i]) * a[i];
+		const __uint128_t low = static_cast<__uint128_t>(out[2 * i]) +
+								static_cast<limb_t>(square) + carry;
+		out[2 * i] = static_cast<limb_t>(low);
+		const __uint128_t high =
+			static_cast<__uint128_t>(out[2 * i + 1]) + static_cast<limb_t>(square >> 64) +
+			static_cast<limb_t>(low >> 64);
+		out[2 * i + 1] = static_cast<limb_t>(high);
+		carry = static_cast<unsigned char>(high >> 64);
+	}
+	assert(carry == 0);
+}
+
+void UnsignedBigInt::sqr_karatsuba(base_t* out, const base_t* a, size_t n, base_t* scratch) {
+	assert(n >= 2);
+
+	const size_t lo = (n + 1) / 2;
+	const size_t hi = n - lo;
+
+	// same layout as mul_karatsuba, |a0 - a1| lives in m until the middle term is formed
+	base_t* t = scratch;
+	base_t* m = scratch + 2 * lo;
+	base_t* rest = m + 2 * lo + 1;
+
+	abs_diff(m, a, lo, a + lo, hi);
+
+	// the subproducts forward to sqr_n, their operands being the same span
+	const Subproduct products[] = {
+		{ t, m, m, lo },
+		{ out, a, a, lo },
+		{ out + 2 * lo, a + lo, a + lo, hi },
+	};
+	mul_subproducts(products, 3, n, rest);
+
+	// middle term: 2 a0 a1 = a0^2 + a1^2 - (a0 - a1)^2, never negative
+	m[2 * lo] = add(m, out, 2 * lo, out + 2 * lo, 2 * hi);
+	sub(m, m, 2 * lo + 1, t, 2 * lo);
+
+	add_into(out, 2 * n, lo, m, 2 * lo + 1);
+}
+
+// ----------------------------------------------------------------------------
+// toom-3
+// ----------------------------------------------------------------------------
+namespace {
+
+/// @brief evaluates a0 + a1 x + a2 x^2 at 1, -1 and 2 into k + 1 limb buffers
+/// @return true if the value at -1 is negative, in which case em1 holds its magnitude
+inline bool toom3_evaluate(
+	const limb_t* a, size_t k, size_t r, limb_t* e1, limb_t* em1, limb_t* e2) {
+	const limb_t* a0 = a;
+	const limb_t* a1 = a + k;
+	const limb_t* a2 = a + 2 * k;
+
+	// e1 = a0 + a2, em1 = |a0 + a2 - a1|, e1 += a1
+	e1[k] = add(e1, a0, k, a2, r);
+	const bool negative = abs_diff(em1, e1, k + 1, a1, k);
+	add(e1, e1, k + 1, a1, k);
+
+	// e2 = (2 * a2 + a1) * 2 + a0
+	tc_extend(e2, a2, r, k + 1);
+	lshift(e2, e2, k + 1, 1);
+	add(e2, e2, k + 1, a1, k);
+	lshift(e2, e2, k + 1, 1);
+	add(e2, e2, k + 1, a0, k);
+
+	return negative;
+}
+
+} // namespace
+
+void UnsignedBigInt::mul_toom3(base_t* out, const base_t* a, const base_t* b, size_t n,
+							   base_t* scratch) {
+	const size_t k = (n + 2) / 3;
+	const size_t r = n - 2 * k;
+	assert(r > 0 && r <= k);
+
+	// evaluated operands take k + 1 limbs, their products 2k + 2 limbs plus a sign limb
+	const size_t e = k + 1;
+	const size_t L = 2 * k + 3;
+
+	base_t* ea1 = scratch;
+	base_t* eam1 = ea1 + e;
+	base_t* ea2 = eam1 + e;
+	base_t* eb1 = ea2 + e;
+	base_t* ebm1 = eb1 + e;
+	base_t* eb2 = ebm1 + e;
+	base_t* w1 = eb2 + e;
+	base_t* wm1 = w1 + L;
+	base_t* w2 = wm1 + L;
+	base_t* w0 = w2 + L;
+	base_t* winf = w0 + L;
+	base_t* rest = winf + L;
+
+	// when squaring, b's evaluations alias a's so every mul_n below forwards to sqr_n
+	const bool square = a == b;
+	if(square) {
+		eb1 = ea1;
+		ebm1 = eam1;
+		eb2 = ea2;
+	}
+	const bool a_negative = toom3_evaluate(a, k, r, ea1, eam1, ea2);
+	const bool b_negative = square ? a_negative : toom3_evaluate(b, k, r, eb1, ebm1, eb2);
+
+	// the products at 0 and inf land directly in place
+	const Subproduct products[] = {
+		{ w1, ea1, eb1, e },
+		{ wm1, eam1, ebm1, e },
+		{ w2, ea2, eb2, e },
+		{ out, a, b, k },
+		{ out + 4 * k, a + 2 * k, b + 2 * k, r },
+	};
+	mul_subproducts(products, 5, n, rest);
+	std::fill(out + 2 * k, out + 4 * k, 0);
+	w1[L - 1] = wm1[L - 1] = w2[L - 1] = 0;
+	if(a_negative != b_negative) {
+		tc_negate(wm1, L);
+	}
+	tc_extend(w0, out, 2 * k, L);
+	tc_extend(winf, out + 4 * k, 2 * r, L);
+
+	tc_sub(w2, w2, wm1, L); // w2 = (w2 - wm1) / 3 = c1 + c2 + 3 c3 + 5 c4
+	divexact_by3(w2, L);
+	tc_sub(w1, w1, wm1, L); // w1 = (w1 - wm1) / 2 = c1 + c3
+	tc_shr(w1, L, 1);
+	tc_add(wm1, wm1, w1, L); // wm1 = c0 + c2 + c4 - c0 - c4 = c2
+	tc_sub(wm1, wm1, w0, L);
+	tc_sub(wm1, wm1, winf, L);
+	tc_sub(w2, w2, w1, L); // w2 = (2 c3 + 5 c4 - 5 c4) / 2 = c3
+	tc_sub(w2, w2, wm1, L);
+	tc_sub(w2, w2, winf, L);
+	tc_sub_shifted(w2, winf, 2, w0, L);
+	tc_shr(w2, L, 1);
+	tc_sub(w1, w1, w2, L); // w1 = c1
+
+	add_into(out, 2 * n, k, w1, L);
+	add_into(out, 2 * n, 2 * k, wm1, L);
+	add_into(out, 2 * n, 3 * k, w2, L);
+}
+
+// ----------------------------------------------------------------------------
+// toom-4
+// ----------------------------------------------------------------------------
+namespace {
+
+/// @brief evaluates a0 + a1 x + a2 x^2 + a3 x^3 at 1, -1, 2, -2 and 8 * a(1/2)
+/// into k + 1 limb buffers, negative values are stored as magnitudes
+/// @return bit 0 set if a(-1) is negative, bit 1 set if a(-2) is negative
+inline unsigned toom4_evaluate(const limb_t* a,
+							   size_t k,
+							   size_t r,
+							   limb_t* e1,
+							   limb_t* em1,
+							   limb_t* e2,
+							   limb_t* em2,
+							   limb_t* eh,
+							   limb_t* tmp) {
+	const limb_t* a0 = a;
+	const limb_t* a1 = a + k;
+	const limb_t* a2 = a + 2 * k;
+	const limb_t* a3 = a + 3 * k;
+	limb_t* even = tmp;
+	limb_t* odd = tmp + k + 1;
+	unsigned negative = 0;
+
+	// even = a0 + a2, odd = a1 + a3
+	even[k] = add(even, a0, k, a2, k);
+	odd[k] = add(odd, a1, k, a3, r);
+	add(e1, even, k + 1, odd, k + 1);
+	negative |= abs_diff(em1, even, k + 1, odd, k + 1);
+
+	// even = a0 + 4 a2, odd = 2 (a1 + 4 a3)
+	even[k] = lshift(even, a2, k, 2);
+	add(even, even, k + 1, a0, k);
+	tc_extend(odd, a3, r, k);
+	odd[k] = lshift(odd, odd, k, 2);
+	add(odd, odd, k + 1, a1, k);
+	lshift(odd, odd, k + 1, 1);
+	add(e2, even, k + 1, odd, k + 1);
+	negative |= abs_diff(em2, even, k + 1, odd, k + 1) << 1;
+
+	// eh = ((2 a0 + a1) * 2 + a2) * 2 + a3
+	eh[k] = lshift(eh, a0, k, 1);
+	add(eh, eh, k + 1, a1, k);
+	lshift(eh, eh, k + 1, 1);
+	add(eh, eh, k + 1, a2, k);
+	lshift(eh, eh, k + 1, 1);
+	add(eh, eh, k + 1, a3, r);
+
+	return negative;
+}
+
+} // namespace
+
+void UnsignedBigInt::mul_toom4(base_t* out, const base_t* a, const base_t* b, size_t n,
+							   base_t* scratch) {
+	const size_t k = (n + 3) / 4;
+	const size_t r = n - 3 * k;
+	assert(r > 0 && r <= k);
+
+	const size_t e = k + 1;
+	const size_t L = 2 * k + 3;
+
+	base_t* ea = scratch; // [1, -1, 2, -2, 1/2] for a
+	base_t* eb = ea + 5 * e; // [1, -1, 2, -2, 1/2] for b
+	base_t* tmp = ea + 10 * e; // 2e limbs for evaluation, L limbs for interpolation
+	base_t* v1 = tmp + L;
+	base_t* vm1 = v1 + L;
+	base_t* v2 = vm1 + L;
+	base_t* vm2 = v2 + L;
+	base_t* vh = vm2 + L;
+	base_t* v0 = vh + L;
+	base_t* vinf = v0 + L;
+	base_t* rest = vinf + L;
+
+	// when squaring, b's evaluations alias a's so every mul_n below forwards to sqr_n
+	const bool square = a == b;
+	if(square) {
+		eb = ea;
+	}
+	const unsigned a_negative = toom4_evaluate(
+		a, k, r, ea, ea + e, ea + 2 * e, ea + 3 * e, ea + 4 * e, tmp);
+	const unsigned b_negative = square ? a_negative
+									   : toom4_evaluate(b, k, r, eb, eb + e, eb + 2 * e,
+														eb + 3 * e, eb + 4 * e, tmp);
+	const unsigned negative = a_negative ^ b_negative;
+
+	base_t* values[] = { v1, vm1, v2, vm2, vh };
+	Subproduct products[7];
+	for(size_t i = 0; i < 5; i++) {
+		products[i] = { values[i], ea + i * e, eb + i * e, e };
+	}
+	products[5] = { out, a, b, k };
+	products[6] = { out + 6 * k, a + 3 * k, b + 3 * k, r };
+	mul_subproducts(products, 7, n, rest);
+	std::fill(out + 2 * k, out + 6 * k, 0);
+	for(base_t* value : values) {
+		value[L - 1] = 0;
+	}
+	if(negative & 1) {
+		tc_negate(vm1, L);
+	}
+	if(negative & 2) {
+		tc_negate(vm2, L);
+	}
+	tc_extend(v0, out, 2 * k, L);
+	tc_extend(vinf, out + 6 * k, 2 * r, L);
+
+	// split odd and even coefficients
+	tc_sub(v1, v1, vm1, L); // v1 = (v1 - vm1) / 2 = c1 + c3 + c5
+	tc_shr(v1, L, 1);
+	tc_add(vm1, vm1, v1, L); // vm1 = c0 + c2 + c4 + c6
+	tc_sub(v2, v2, vm2, L); // v2 = (v2 - vm2) / 4 = c1 + 4 c3 + 16 c5
+	tc_shr(v2, L, 2);
+	tc_add(vm2, vm2, v2, L); // vm2 = c0 + 4 c2 + 16 c4 + 64 c6
+	tc_add(vm2, vm2, v2, L);
+
+	// even coefficients
+	tc_sub(vm1, vm1, v0, L); // vm1 = c2 + c4
+	tc_sub(vm1, vm1, vinf, L);
+	tc_sub(vm2, vm2, v0, L); // vm2 = c2 + 4 c4
+	tc_sub_shifted(vm2, vinf, 6, tmp, L);
+	tc_shr(vm2, L, 2);
+	tc_sub(vm2, vm2, vm1, L); // vm2 = c4
+	divexact_by3(vm2, L);
+	tc_sub(vm1, vm1, vm2, L); // vm1 = c2
+
+	// vh = (vh - 64 c0 - 16 c2 - 4 c4 - c6) / 2 = 16 c1 + 4 c3 + c5
+	tc_sub_shifted(vh, v0, 6, tmp, L);
+	tc_sub_shifted(vh, vm1, 4, tmp, L);
+	tc_sub_shifted(vh, vm2, 2, tmp, L);
+	tc_sub(vh, vh, vinf, L);
+	tc_shr(vh, L, 1);
+
+	// odd coefficients
+	tc_sub(v2, v2, v1, L); // v2 = c3 + 5 c5
+	divexact_by3(v2, L);
+	lshift(tmp, v1, L, 4); // vh = 4 c3 + 5 c5
+	tc_sub(vh, tmp, vh, L);
+	divexact_by3(vh, L);
+	tc_sub(vh, vh, v2, L); // vh = c3
+	divexact_by3(vh, L);
+	tc_sub(v2, v2, vh, L); // v2 = c5
+	divexact_1(v2, L, 5);
+	tc_sub(v1, v1, vh, L); // v1 = c1
+	tc_sub(v1, v1, v2, L);
+
+	add_into(out, 2 * n, k, v1, L);
+	add_into(out, 2 * n, 2 * k, vm1, L);
+	add_into(out, 2 * n, 3 * k, vh, L);
+	add_into(out, 2 * n, 4 * k, vm2, L);
+	add_into(out, 2 * n, 5 * k, v2, L);
+}
+
+// ----------------------------------------------------------------------------
+// dispatch
+// ----------------------------------------------------------------------------
+void UnsignedBigInt::mul_subproducts(const Subproduct* products, size_t count, size_t n,
+									 base_t* scratch) {
+	if(!should_fork(n)) {
+		for(size_t i = 0; i < count; i++) {
+			mul_n(products[i].out, products[i].a, products[i].b, products[i].n, scratch);
+		}
+		return;
+	}
+
+	// the first subproduct stays on this thread and the caller's scratch. a task takes its
+	// scratch where it runs, which may be this thread while it waits, nesting its frame
+	// inside the ones already open here
+	ThreadPool::TaskGroup group(*current_pool());
+	for(size_t i = 1; i < count; i++) {
+		group.run([product = products[i]]() {
+			Workspace::Frame frame(current_workspace());
+			mul_n(product.out,
+				  product.a,
+				  product.b,
+				  product.n,
+				  frame.take(mul_n_scratch_size(product.n)));
+		});
+	}
+	mul_n(products[0].out, products[0].a, products[0].b, products[0].n, scratch);
+	group.wait();
+}
+
+bool UnsignedBigInt::ifma_base_case(size_t n) noexcept {
+	static_assert(IFMA_KARATSUBA_THRESHOLD <= ifma::MAX_MUL_LIMBS + 1,
+				  "the IFMA kernel bounds the operand sizes it sums");
+	return n >= IFMA_THRESHOLD && n < IFMA_KARATSUBA_THRESHOLD && ifma::enabled();
+}
+
+void UnsignedBigInt::mul_n(base_t* out, const base_t* a, const base_t* b, size_t n,
+						   base_t* scratch) {
+	if(a == b) {
+		sqr_n(out, a, n, scratch);
+	} else if(ifma_base_case(n)) {
+		ifma::mul(out, a, n, b, n);
+	} else if(n < KARATSUBA_THRESHOLD) {
+		mul_schoolbook(out, a, n, b, n);
+	} else if(n < TOOM3_THRESHOLD) {
+		mul_karatsuba(out, a, b, n, scratch);
+	} else if(n < TOOM4_THRESHOLD) {
+		mul_toom3(out, a, b, n, scratch);
+	} else if(n < FFT_THRESHOLD) {
+		mul_toom4(out, a, b, n, scratch);
+	} else {
+		mul_fft(out, a, n, b, n);
+	}
+}
+
+void UnsignedBigInt::sqr_n(base_t* out, const base_t* a, size_t n, base_t* scratch) {
+	if(ifma_base_case(n)) {
+		ifma::mul(out, a, n, a, n);
+	} else if(n < SQR_KARATSUBA_THRESHOLD) {
+		sqr_schoolbook(out, a, n);
+	} else if(n < TOOM3_THRESHOLD) {
+		sqr_karatsuba(out, a, n, scratch);
+	} else if(n < TOOM4_THRESHOLD) {
+		mul_toom3(out, a, a, n, scratch);
+	} else if(n < FFT_THRESHOLD) {
+		mul_toom4(out, a, a, n, scratch);
+	} else {
+		mul_fft(out, a, n, a, n);
+	}
+}
+
+void UnsignedBigInt::mul_limbs(
+	base_t* out, const base_t* a, size_t an, const base_t* b, size_t bn, base_t* scratch) {
+	assert(an >= bn);
+
+	if(an == bn) {
+		mul_n(out, a, b, an, scratch);
+		return;
+	}
+
+	if(ifma_base_case(bn)) {
+		ifma::mul(out, a, an, b, bn);
+		return;
+	}
+
+	if(bn < KARATSUBA_THRESHOLD) {
+		mul_schoolbook(out, a, an, b, bn);
+		return;
+	}
+
+	if(bn >= FFT_THRESHOLD) {
+		// the transform length only depends on an + bn, no need to chunk
+		mul_fft(out, a, an, b, bn);
+		return;
+	}
+
+	// unbalanced operands: cut a into bn limb chunks and accumulate each chunk's product
+	base_t* tmp = scratch;
+	base_t* rest = scratch + 2 * bn;
+
+	mul_n(out, a, b, bn, rest);
+	for(size_t offset = bn; offset < an; offset += bn) {
+		const size_t len = std::min(bn, an - offset);
+		if(len == bn) {
+			mul_n(tmp, a + offset, b, bn, rest);
+		} else {
+			mul_limbs(tmp, b, bn, a + offset, len, rest);
+		}
+
+		// the upper bn limbs of the previous chunk overlap the lower limbs of this one
+		[[maybe_unused]] const base_t carry =
+			add(out + offset, tmp, len + bn, out + offset, bn);
+		assert(carry == 0);
+	}
+}
+
+size_t UnsignedBigInt::karatsuba_scratch_size(size_t n) noexcept {
+	const size_t lo = (n + 1) / 2;
+	return 4 * lo + 1 + std::max(mul_n_scratch_size(lo), mul_n_scratch_size(n - lo));
+}
+
+size_t UnsignedBigInt::toom3_scratch_size(size_t n) noexcept {
+	const size_t k = (n + 2) / 3;
+	const size_t recursion = std::max(
+		{ mul_n_scratch_size(k + 1), mul_n_scratch_size(k), mul_n_scratch_size(n - 2 * k) });
+	return 6 * (k + 1) + 5 * (2 * k + 3) + recursion;
+}
+
+size_t UnsignedBigInt::toom4_scratch_size(size_t n) noexcept {
+	const size_t k = (n + 3) / 4;
+	const size_t recursion = std::max(
+		{ mul_n_scratch_size(k + 1), mul_n_scratch_size(k), mul_n_scratch_size(n - 3 * k) });
+	return 10 * (k + 1) + 8 * (2 * k + 3) + recursion;
+}
+
+size_t UnsignedBigInt::mul_n_scratch_size(size_t n) noexcept {
+	if(n < KARATSUBA_THRESHOLD) {
+		return 0;
+	} else if(n < TOOM3_THRESHOLD) {
+		return karatsuba_scratch_size(n);
+	} else if(n < TOOM4_THRESHOLD) {
+		return toom3_scratch_size(n);
+	} else if(n < FFT_THRESHOLD) {
+		return toom4_scratch_size(n);
+	}
+	return 0;
+}
+
+size_t UnsignedBigInt::mul_scratch_size(size_t an, size_t bn) noexcept {
+	if(an == bn) {
+		return mul_n_scratch_size(bn);
+	}
+	if(bn < KARATSUBA_THRESHOLD) {
+		return 0;
+	}
+	if(bn >= FFT_THRESHOLD) {
+		return 0;
+	}
+
+	size_t size = 2 * bn + mul_n_scratch_size(bn);
+	if(an % bn) {
+		size = std::max(size, 2 * bn + mul_scratch_size(bn, an % bn));
+	}
+	return size;
+}
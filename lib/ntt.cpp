@@ -0,0 +1,458 @@
+#include "include/bignum.hpp"
+#include "include/limbs.hpp"
+#include "include/thread_pool.hpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+using namespace limbs;
+
+// ============================================================================
+// Section: modular arithmetic
+// ============================================================================
+// products are computed modulo three ~62 bit primes of the form c * 2^k + 1 and recombined
+// with the chinese remainder theorem. p0 * p1 * p2 > 2^184 bounds every convolution term of
+// 64 bit limbs for transforms of up to 2^55 points.
+namespace {
+
+constexpr limb_t pow_mod(limb_t base, limb_t exp, limb_t p) {
+	limb_t ret = 1;
+	base %= p;
+	while(exp) {
+		if(exp & 1) {
+			ret = static_cast<limb_t>(static_cast<__uint128_t>(ret) * base % p);
+		}
+		base = static_cast<limb_t>(static_cast<__uint128_t>(base) * base % p);
+		exp >>= 1;
+	}
+	return ret;
+}
+
+/// @brief arithmetic modulo an odd p < 2^63 with values kept in montgomery form x * 2^64 mod p
+struct NttPrime {
+	limb_t p;
+	limb_t generator;
+	limb_t neg_inverse; // -p^-1 mod 2^64
+	limb_t r2; // 2^128 mod p
+	size_t max_log2; // largest k with 2^k | p - 1
+
+	constexpr NttPrime(limb_t p, limb_t generator)
+		: p(p)
+		, generator(generator)
+		, neg_inverse(0)
+		, r2(0)
+		, max_log2(__builtin_ctzll(p - 1)) {
+		// newton iteration for p^-1 mod 2^64, each step doubles the number of correct bits
+		limb_t inverse = p;
+		for(int i = 0; i < 5; i++) {
+			inverse *= 2 - p * inverse;
+		}
+		neg_inverse = -inverse;
+
+		const limb_t r = static_cast<limb_t>((static_cast<__uint128_t>(1) << 64) % p);
+		r2 = static_cast<limb_t>(static_cast<__uint128_t>(r) * r % p);
+	}
+
+	/// @brief montgomery reduction of t < p * 2^64 into [0, 2p)
+	constexpr limb_t reduce_lazy(__uint128_t t) const {
+		const limb_t m = static_cast<limb_t>(t) * neg_inverse;
+		return static_cast<limb_t>((t + static_cast<__uint128_t>(m) * p) >> 64);
+	}
+
+	/// @brief montgomery reduction of t < p * 2^64
+	constexpr limb_t reduce(__uint128_t t) const {
+		const limb_t ret = reduce_lazy(t);
+		return ret >= p ? ret - p : ret;
+	}
+
+	/// @brief a * b / 2^64 mod p. with one operand in montgomery form the result is in the
+	/// form of the other operand
+	constexpr limb_t mul(limb_t a, limb_t b) const {
+		return reduce(static_cast<__uint128_t>(a) * b);
+	}
+
+	constexpr limb_t mul_lazy(limb_t a, limb_t b) const {
+		return reduce_lazy(static_cast<__uint128_t>(a) * b);
+	}
+
+	constexpr limb_t add(limb_t a, limb_t b) const {
+		const limb_t sum = a + b;
+		return sum >= p ? sum - p : sum;
+	}
+
+	constexpr limb_t sub(limb_t a, limb_t b) const {
+		return a >= b ? a - b : a + p - b;
+	}
+
+	/// @brief converts any 64 bit value into montgomery form
+	constexpr limb_t to_montgomery(limb_t a) const {
+		return mul(a, r2);
+	}
+
+	/// @brief a^exp in montgomery form for a in montgomery form
+	constexpr limb_t pow(limb_t a, limb_t exp) const {
+		limb_t ret = to_montgomery(1);
+		while(exp) {
+			if(exp & 1) {
+				ret = mul(ret, a);
+			}
+			a = mul(a, a);
+			exp >>= 1;
+		}
+		return ret;
+	}
+};
+
+constexpr std::array<NttPrime, 3> PRIMES = {
+	NttPrime(4179340454199820289ull, 3), // 29 * 2^57 + 1
+	NttPrime(2485986994308513793ull, 5), // 69 * 2^55 + 1
+	NttPrime(1945555039024054273ull, 5), // 27 * 2^56 + 1
+};
+
+// garner's constants, stored in montgomery form so that multiplying a plain value by them
+// yields a plain value
+constexpr limb_t P0_INVERSE_MOD_P1 =
+	PRIMES[1].to_montgomery(pow_mod(PRIMES[0].p, PRIMES[1].p - 2, PRIMES[1].p));
+constexpr limb_t P0_MOD_P2 = PRIMES[2].to_montgomery(PRIMES[0].p % PRIMES[2].p);
+constexpr __uint128_t P0P1 = static_cast<__uint128_t>(PRIMES[0].p) * PRIMES[1].p;
+constexpr limb_t P0P1_INVERSE_MOD_P2 = PRIMES[2].to_montgomery(
+	pow_mod(static_cast<limb_t>(P0P1 % PRIMES[2].p), PRIMES[2].p - 2, PRIMES[2].p));
+
+// ============================================================================
+// Section: parallel loops
+// ============================================================================
+// inside a ParallelScope the loops over the points of a transform are split into chunks of at
+// least the grain, and transforms of at least twice the grain fork their two halves
+
+/// @brief f(begin, end) over [0, n), in chunks on the current pool when n reaches its grain
+template <typename F>
+void parallel_for(size_t n, const F& f) {
+	if(!should_fork(n)) {
+		f(size_t(0), n);
+		return;
+	}
+
+	ThreadPool& pool = *current_pool();
+	const size_t chunks = std::min(n / current_grain(), 4 * pool.threads());
+	const size_t step = (n + chunks - 1) / chunks;
+	ThreadPool::TaskGroup group(pool);
+	for(size_t begin = step; begin < n; begin += step) {
+		group.run([&f, begin, end = std::min(begin + step, n)]() { f(begin, end); });
+	}
+	f(size_t(0), std::min(step, n));
+	group.wait();
+}
+
+/// @brief runs first on a task and second on the calling thread when size reaches the grain
+template <typename F, typename G>
+void parallel_invoke(size_t size, const F& first, const G& second) {
+	if(!should_fork(size)) {
+		first();
+		second();
+		return;
+	}
+
+	ThreadPool::TaskGroup group(*current_pool());
+	group.run([&first]() { first(); });
+	second();
+	group.wait();
+}
+
+// ============================================================================
+// Section: transforms
+// ============================================================================
+
+// the loop bodies below take everything by value: a limb store could alias a size or a limb
+// captured by reference and force it to be reloaded on every iteration
+
+/// @brief row[j] = w^j for j in [begin, end)
+void fill_powers(limb_t* row, limb_t w, size_t begin, size_t end, const NttPrime& prime) {
+	row[begin] = prime.pow(w, begin);
+	for(size_t j = begin + 1; j < end; j++) {
+		row[j] = prime.mul(row[j - 1], w);
+	}
+}
+
+/// @brief fills roots[len + j] = w_2len^j for every power of two len < n, where w_2len is a
+/// principal 2len-th root of unity (or its inverse)
+void build_roots(limb_t* roots, size_t n, const NttPrime& prime, bool inverse) {
+	const limb_t g = prime.to_montgomery(prime.generator);
+
+	for(size_t len = 1; len < n; len <<= 1) {
+		limb_t w = prime.pow(g, (prime.p - 1) / (2 * len));
+		if(inverse) {
+			w = prime.pow(w, 2 * len - 1);
+		}
+
+		// every chunk starts from its own power so the chunks of a long row are independent
+		limb_t* row = roots + len;
+		parallel_for(len, [row, w, &prime](size_t begin, size_t end) {
+			fill_powers(row, w, begin, end, prime);
+		});
+	}
+}
+
+// the butterflies keep values lazily reduced in [0, 2p), which is safe since 4p < 2^64, and
+// only fully reduce once the transform is done
+
+inline void forward_butterflies(
+	limb_t* x, limb_t* y, const limb_t* w, size_t begin, size_t end, const NttPrime& prime) {
+	const limb_t p2 = 2 * prime.p;
+	for(size_t j = begin; j < end; j++) {
+		const limb_t u = x[j];
+		const limb_t v = y[j];
+		const limb_t sum = u + v;
+		x[j] = sum >= p2 ? sum - p2 : sum;
+		y[j] = prime.mul_lazy(u - v + p2, w[j]);
+	}
+}
+
+inline void inverse_butterflies(
+	limb_t* x, limb_t* y, const limb_t* w, size_t begin, size_t end, const NttPrime& prime) {
+	const limb_t p2 = 2 * prime.p;
+	for(size_t j = begin; j < end; j++) {
+		const limb_t u = x[j];
+		const limb_t v = prime.mul_lazy(y[j], w[j]);
+		const limb_t sum = u + v;
+		const limb_t diff = u - v + p2;
+		x[j] = sum >= p2 ? sum - p2 : sum;
+		y[j] = diff >= p2 ? diff - p2 : diff;
+	}
+}
+
+/// @brief decimation in frequency transform: natural order in, bit reversed order out
+void ntt_forward_serial(limb_t* a, size_t n, const limb_t* roots, const NttPrime& prime) {
+	for(size_t len = n / 2; len >= 1; len >>= 1) {
+		for(size_t i = 0; i < n; i += 2 * len) {
+			forward_butterflies(a + i, a + i + len, roots + len, 0, len, prime);
+		}
+	}
+}
+
+/// @brief decimation in time transform: bit reversed order in, natural order out. unscaled
+void ntt_inverse_serial(limb_t* a, size_t n, const limb_t* roots, const NttPrime& prime) {
+	for(size_t len = 1; len < n; len <<= 1) {
+		for(size_t i = 0; i < n; i += 2 * len) {
+			inverse_butterflies(a + i, a + i + len, roots + len, 0, len, prime);
+		}
+	}
+}
+
+/// @brief ntt_forward_serial, forking once the halves reach the grain. after the first stage
+/// the two halves are independent transforms of half the size
+void ntt_forward(limb_t* a, size_t n, const limb_t* roots, const NttPrime& prime) {
+	const size_t half = n / 2;
+	if(!should_fork(half)) {
+		ntt_forward_serial(a, n, roots, prime);
+		return;
+	}
+
+	limb_t* b = a + half;
+	const limb_t* w = roots + half;
+	parallel_for(half, [a, b, w, &prime](size_t begin, size_t end) {
+		forward_butterflies(a, b, w, begin, end, prime);
+	});
+	parallel_invoke(
+		half,
+		[b, half, roots, &prime]() { ntt_forward(b, half, roots, prime); },
+		[a, half, roots, &prime]() { ntt_forward(a, half, roots, prime); });
+}
+
+/// @brief ntt_inverse_serial, forking once the halves reach the grain. the halves are
+/// transformed independently before the last stage joins them
+void ntt_inverse(limb_t* a, size_t n, const limb_t* roots, const NttPrime& prime) {
+	const size_t half = n / 2;
+	if(!should_fork(half)) {
+		ntt_inverse_serial(a, n, roots, prime);
+		return;
+	}
+
+	limb_t* b = a + half;
+	const limb_t* w = roots + half;
+	parallel_invoke(
+		half,
+		[b, half, roots, &prime]() { ntt_inverse(b, half, roots, prime); },
+		[a, half, roots, &prime]() { ntt_inverse(a, half, roots, prime); });
+	parallel_for(half, [a, b, w, &prime](size_t begin, size_t end) {
+		inverse_butterflies(a, b, w, begin, end, prime);
+	});
+}
+
+/// @brief dst[i] = src[i] in montgomery form for i in [begin, end), zero from n on
+void load_range(
+	limb_t* dst, const limb_t* src, size_t n, size_t begin, size_t end, const NttPrime& prime) {
+	const size_t loaded = std::clamp(n, begin, end);
+	for(size_t i = begin; i < loaded; i++) {
+		dst[i] = prime.to_montgomery(src[i]);
+	}
+	std::fill(dst + loaded, dst + end, 0);
+}
+
+/// @brief loads n limbs into montgomery form, zero padding up to size
+void load(limb_t* dst, const limb_t* src, size_t n, size_t size, const NttPrime& prime) {
+	parallel_for(size, [dst, src, n, &prime](size_t begin, size_t end) {
+		load_range(dst, src, n, begin, end, prime);
+	});
+}
+
+/// @brief fa[i] = fa[i] * fb[i] for i in [begin, end)
+void mul_pointwise(limb_t* fa, const limb_t* fb, size_t begin, size_t end, const NttPrime& prime) {
+	for(size_t i = begin; i < end; i++) {
+		fa[i] = prime.mul_lazy(fa[i], fb[i]);
+	}
+}
+
+/// @brief fa[i] = fa[i] * factor, fully reduced, for i in [begin, end)
+void mul_scalar(limb_t* fa, limb_t factor, size_t begin, size_t end, const NttPrime& prime) {
+	for(size_t i = begin; i < end; i++) {
+		fa[i] = prime.mul(fa[i], factor);
+	}
+}
+
+/// @brief cyclic convolution of a and b modulo one prime, leaving plain residues in fa
+void convolve(limb_t* fa,
+			  limb_t* fb,
+			  limb_t* roots,
+			  const limb_t* a,
+			  size_t an,
+			  const limb_t* b,
+			  size_t bn,
+			  size_t n,
+			  const NttPrime& prime) {
+	build_roots(roots, n, prime, false);
+
+	if(fb != nullptr) {
+		parallel_invoke(
+			n,
+			[&]() {
+				load(fb, b, bn, n, prime);
+				ntt_forward(fb, n, roots, prime);
+			},
+			[&]() {
+				load(fa, a, an, n, prime);
+				ntt_forward(fa, n, roots, prime);
+			});
+		parallel_for(n, [fa, fb, &prime](size_t begin, size_t end) {
+			mul_pointwise(fa, fb, begin, end, prime);
+		});
+	} else {
+		load(fa, a, an, n, prime);
+		ntt_forward(fa, n, roots, prime);
+		parallel_for(n, [fa, &prime](size_t begin, size_t end) {
+			mul_pointwise(fa, fa, begin, end, prime);
+		});
+	}
+
+	build_roots(roots, n, prime, true);
+	ntt_inverse(fa, n, roots, prime);
+
+	// fold the 1/n scaling into the conversion out of montgomery form
+	const limb_t n_inverse = pow_mod(n % prime.p, prime.p - 2, prime.p);
+	parallel_for(n, [fa, n_inverse, &prime](size_t begin, size_t end) {
+		mul_scalar(fa, n_inverse, begin, end, prime);
+	});
+}
+
+/// @brief garner's algorithm: replaces the residues of the coefficients in [begin, end) with
+/// their three limbs, in place. every coefficient is below 2^185
+void recombine(limb_t* r0, limb_t* r1, limb_t* r2, size_t begin, size_t end) {
+	const NttPrime& p1 = PRIMES[1];
+	const NttPrime& p2 = PRIMES[2];
+	for(size_t i = begin; i < end; i++) {
+		const limb_t v0 = r0[i];
+
+		limb_t v0_mod = v0 >= p1.p ? v0 - p1.p : v0;
+		const limb_t v1 = p1.mul(p1.sub(r1[i], v0_mod), P0_INVERSE_MOD_P1);
+
+		v0_mod = v0;
+		while(v0_mod >= p2.p) {
+			v0_mod -= p2.p;
+		}
+		const limb_t partial = p2.add(v0_mod, p2.mul(v1, P0_MOD_P2));
+		const limb_t v2 = p2.mul(p2.sub(r2[i], partial), P0P1_INVERSE_MOD_P2);
+
+		// x = v0 + v1 * p0 + v2 * p0 * p1, as three limbs
+		const __uint128_t low = static_cast<__uint128_t>(v1) * PRIMES[0].p + v0;
+		const __uint128_t mid = static_cast<__uint128_t>(v2) * static_cast<limb_t>(P0P1);
+		const __uint128_t high = static_cast<__uint128_t>(v2) * static_cast<limb_t>(P0P1 >> 64);
+
+		const __uint128_t s0 =
+			static_cast<__uint128_t>(static_cast<limb_t>(low)) + static_cast<limb_t>(mid);
+		const __uint128_t s1 = (low >> 64) + (mid >> 64) + static_cast<limb_t>(high) + (s0 >> 64);
+		r0[i] = static_cast<limb_t>(s0);
+		r1[i] = static_cast<limb_t>(s1);
+		r2[i] = static_cast<limb_t>(high >> 64) + static_cast<limb_t>(s1 >> 64);
+	}
+}
+
+} // namespace
+
+// ============================================================================
+// Section: limb kernels
+// ============================================================================
+void UnsignedBigInt::mul_fft(base_t* out, const base_t* a, size_t an, const base_t* b, size_t bn) {
+	const bool square = a == b && an == bn;
+	const size_t terms = an + bn - 1;
+	size_t n = 1;
+	while(n < terms) {
+		n <<= 1;
+	}
+	assert(static_cast<size_t>(__builtin_ctzll(n)) <= PRIMES[1].max_log2);
+
+	// inside a ParallelScope the three primes run side by side, each on its own buffers
+	const bool parallel = should_fork(n);
+	const size_t copies = parallel ? 3 : 1;
+	Workspace::Frame frame(current_workspace());
+	limb_t* residues = frame.take(3 * n);
+	limb_t* fb = square ? nullptr : frame.take(copies * n);
+	limb_t* roots = frame.take(copies * n);
+
+	auto run_prime = [&](size_t i) {
+		const size_t copy = parallel ? i : 0;
+		convolve(residues + i * n,
+				 fb != nullptr ? fb + copy * n : nullptr,
+				 roots + copy * n,
+				 a,
+				 an,
+				 b,
+				 bn,
+				 n,
+				 PRIMES[i]);
+	};
+	if(parallel) {
+		ThreadPool::TaskGroup group(*current_pool());
+		group.run([&run_prime]() { run_prime(1); });
+		group.run([&run_prime]() { run_prime(2); });
+		run_prime(0);
+		group.wait();
+	} else {
+		for(size_t i = 0; i < 3; i++) {
+			run_prime(i);
+		}
+	}
+
+	// recombine the coefficients into three limbs each, then add them up
+	limb_t* r0 = residues;
+	limb_t* r1 = residues + n;
+	limb_t* r2 = residues + 2 * n;
+	parallel_for(terms, [r0, r1, r2](size_t begin, size_t end) {
+		recombine(r0, r1, r2, begin, end);
+	});
+
+	// the running carry stays below 2^122
+	__uint128_t carry = 0;
+	for(size_t i = 0; i < terms; i++) {
+		const __uint128_t s0 = static_cast<__uint128_t>(r0[i]) + static_cast<limb_t>(carry);
+		const __uint128_t s1 =
+			static_cast<__uint128_t>(r1[i]) + static_cast<limb_t>(carry >> 64) + (s0 >> 64);
+		out[i] = static_cast<limb_t>(s0);
+		carry = (static_cast<__uint128_t>(r2[i] + static_cast<limb_t>(s1 >> 64)) << 64) |
+				static_cast<limb_t>(s1);
+	}
+
+	out[terms] = static_cast<limb_t>(carry);
+	assert((carry >> 64) == 0);
+}
@@ -0,0 +1,121 @@
+#include "include/radix_cache.hpp"
+
+#include <array>
+#include <cassert>
+#include <mutex>
+#include <optional>
+
+namespace radix_cache {
+
+namespace {
+
+struct Table {
+	// a deque never moves its elements as it grows, so handed out levels stay put
+	std::deque<UnsignedBigInt> levels;
+};
+
+std::mutex mutex;
+std::array<std::shared_ptr<Table>, MAX_BASE + 1> tables;
+size_t usage = 0;
+size_t limit = size_t(64) << 20;
+
+size_t bytes(const UnsignedBigInt& value) noexcept {
+	return value.digits() * sizeof(uint64_t);
+}
+
+} // namespace
+
+// ============================================================================
+// Section: leaves
+// ============================================================================
+size_t levels(unsigned base, size_t digits) noexcept {
+	const size_t leaf = leaf_digits(base);
+	size_t ret = 0;
+	while(ret < 64 && (leaf << ret) < digits) {
+		ret++;
+	}
+	return ret;
+}
+
+// ============================================================================
+// Section: cache
+// ============================================================================
+Powers get(unsigned base, size_t digits) {
+	assert(base >= 2 && base <= MAX_BASE);
+	Powers ret;
+	const size_t wanted = levels(base, digits);
+	if(wanted == 0) {
+		return ret;
+	}
+
+	std::unique_lock lock(mutex);
+	if(!tables[base]) {
+		tables[base] = std::make_shared<Table>();
+	}
+	const std::shared_ptr<Table> table = tables[base];
+	ret.m_table = table;
+
+	// squares are taken without the lock, a thread that loses the race to append its level
+	// drops it and looks again
+	std::optional<UnsignedBigInt> over_limit;
+	while(table->levels.size() < wanted) {
+		const size_t count = table->levels.size();
+		const UnsignedBigInt* top = count ? &table->levels.back() : nullptr;
+		lock.unlock();
+		UnsignedBigInt next = top ? top->square() : UnsignedBigInt(leaf_base(base));
+		lock.lock();
+
+		if(table->levels.size() != count) {
+			continue;
+		}
+		if(tables[base] != table || usage + bytes(next) > limit) {
+			over_limit = std::move(next);
+			break;
+		}
+		usage += bytes(next);
+		table->levels.push_back(std::move(next));
+	}
+	for(size_t k = 0; k < wanted && k < table->levels.size(); k++) {
+		ret.m_levels.push_back(&table->levels[k]);
+	}
+	lock.unlock();
+
+	if(over_limit) {
+		ret.m_local.push_back(std::move(*over_limit));
+		ret.m_levels.push_back(&ret.m_local.back());
+	}
+	while(ret.m_levels.size() < wanted) {
+		ret.m_local.push_back(ret.m_levels.back()->square());
+		ret.m_levels.push_back(&ret.m_local.back());
+	}
+	return ret;
+}
+
+void reserve(unsigned base, size_t digits) {
+	get(base, digits);
+}
+
+void clear() noexcept {
+	std::lock_guard lock(mutex);
+	for(std::shared_ptr<Table>& table : tables) {
+		table.reset();
+	}
+	usage = 0;
+}
+
+void set_memory_limit(size_t bytes) noexcept {
+	std::lock_guard lock(mutex);
+	limit = bytes;
+}
+
+size_t memory_limit() noexcept {
+	std::lock_guard lock(mutex);
+	return limit;
+}
+
+size_t memory_usage() noexcept {
+	std::lock_guard lock(mutex);
+	return usage;
+}
+
+} // namespace radix_cache
@@ -0,0 +1,233 @@
+#include "include/bignum.hpp"
+#include "include/bignum_view.hpp"
+#include "include/limbs.hpp"
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using limbs::limb_t;
+
+// ============================================================================
+// Section: varints
+// ============================================================================
+namespace {
+
+// a 64 bit varint takes at most ten groups of seven bits
+constexpr size_t MAX_VARINT_BYTES = 10;
+
+size_t varint_size(uint64_t value) noexcept {
+	size_t ret = 1;
+	for(; value >= 0x80; value >>= 7) {
+		ret++;
+	}
+	return ret;
+}
+
+/// @return the bytes written
+size_t write_varint(uint8_t* out, uint64_t value) noexcept {
+	size_t ret = 0;
+	for(; value >= 0x80; value >>= 7) {
+		out[ret++] = static_cast<uint8_t>(value | 0x80);
+	}
+	out[ret++] = static_cast<uint8_t>(value);
+	return ret;
+}
+
+/// @brief value = the varint at the front of bytes
+/// @return the bytes read
+/// @throws BigNumInvalidEncodingException if it is truncated, does not fit 64 bits, or ends in
+/// a zero group that a shorter encoding would leave out
+size_t read_varint(std::span<const uint8_t> bytes, uint64_t& value) {
+	value = 0;
+	for(size_t i = 0; i < std::min(bytes.size(), MAX_VARINT_BYTES); i++) {
+		const uint64_t group = bytes[i] & 0x7F;
+		if(i == MAX_VARINT_BYTES - 1 && group > 1) {
+			break;
+		}
+		value |= group << (7 * i);
+		if(!(bytes[i] & 0x80)) {
+			if(group == 0 && i > 0) {
+				break;
+			}
+			return i + 1;
+		}
+	}
+	throw BigNumInvalidEncodingException();
+}
+
+/// @brief the limbs of view for the kernels, read in place when they can be and copied to
+/// scratch from frame otherwise. limbs overlapping the n limbs at avoid are copied too, so the
+/// caller may write there
+const limb_t* operand_limbs(
+	UnsignedBigIntView view, const limb_t* avoid, size_t n, Workspace::Frame& frame) {
+	const limb_t* direct = view.data();
+	if(direct && !view.overlaps(avoid, n * sizeof(limb_t))) {
+		return direct;
+	}
+	limb_t* copy = frame.take(view.digits());
+	for(size_t i = 0; i < view.digits(); i++) {
+		copy[i] = view.limb(i);
+	}
+	return copy;
+}
+
+} // namespace
+
+// ============================================================================
+// Section: encoding
+// ============================================================================
+size_t UnsignedBigInt::serialized_size() const noexcept {
+	// zero is stored without limbs
+	const size_t n = m_digits == 1 && m_container[0] == 0 ? 0 : m_digits;
+	return 1 + varint_size(n) + n * sizeof(base_t);
+}
+
+size_t UnsignedBigInt::serialize(uint8_t* out) const noexcept {
+	const size_t n = m_digits == 1 && m_container[0] == 0 ? 0 : m_digits;
+	size_t size = 0;
+	out[size++] = ENCODING_VERSION;
+	size += write_varint(out + size, n);
+	if constexpr(std::endian::native == std::endian::little) {
+		std::memcpy(out + size, m_container.data(), n * sizeof(base_t));
+	} else {
+		for(size_t i = 0; i < n; i++) {
+			const base_t limb = __builtin_bswap64(m_container[i]);
+			std::memcpy(out + size + i * sizeof(base_t), &limb, sizeof(limb));
+		}
+	}
+	return size + n * sizeof(base_t);
+}
+
+std::vector<uint8_t> UnsignedBigInt::serialize() const {
+	std::vector<uint8_t> ret(serialized_size());
+	serialize(ret.data());
+	return ret;
+}
+
+UnsignedBigInt UnsignedBigInt::deserialize(std::span<const uint8_t> bytes, size_t* consumed) {
+	return UnsignedBigInt(UnsignedBigIntView::decode(bytes, consumed));
+}
+
+UnsignedBigInt::UnsignedBigInt(UnsignedBigIntView view)
+	: m_digits(view.digits())
+	, m_container(std::max(INITIAL_ALLOCATIONS_SIZE, view.digits()), 0) {
+	if(const base_t* limbs = view.data()) {
+		std::copy(limbs, limbs + m_digits, m_container.data());
+	} else {
+		for(size_t i = 0; i < m_digits; i++) {
+			m_container[i] = view.limb(i);
+		}
+	}
+}
+
+// ============================================================================
+// Section: byte export
+// ============================================================================
+std::vector<uint8_t> UnsignedBigInt::to_bytes(std::endian order) const {
+	if(m_digits == 1 && m_container[0] == 0) {
+		return {};
+	}
+
+	// little endian first, then turned around for big endian
+	std::vector<uint8_t> ret((most_significant_bit() + 7) / 8);
+	if constexpr(std::endian::native == std::endian::little) {
+		std::memcpy(ret.data(), m_container.data(), ret.size());
+	} else {
+		for(size_t i = 0; i < ret.size(); i++) {
+			ret[i] = static_cast<uint8_t>(m_container[i / 8] >> (8 * (i % 8)));
+		}
+	}
+	if(order == std::endian::big) {
+		std::reverse(ret.begin(), ret.end());
+	}
+	return ret;
+}
+
+UnsignedBigInt UnsignedBigInt::from_bytes(std::span<const uint8_t> bytes, std::endian order) {
+	UnsignedBigInt ret;
+	const size_t n = (bytes.size() + 7) / 8;
+	if(n == 0) {
+		return ret;
+	}
+
+	if(ret.m_container.size() < n) {
+		ret.m_container.resize(n, 0);
+	}
+	base_t* out = ret.m_container.data();
+	std::fill(out, out + n, 0);
+	if(order == std::endian::little && std::endian::native == std::endian::little) {
+		std::memcpy(out, bytes.data(), bytes.size());
+	} else {
+		for(size_t i = 0; i < bytes.size(); i++) {
+			const uint8_t byte = order == std::endian::big ? bytes[bytes.size() - 1 - i] : bytes[i];
+			out[i / 8] |= static_cast<base_t>(byte) << (8 * (i % 8));
+		}
+	}
+	ret.m_digits = n;
+	ret.normalize();
+	return ret;
+}
+
+// ============================================================================
+// Section: views
+// ============================================================================
+UnsignedBigIntView UnsignedBigIntView::decode(std::span<const uint8_t> bytes, size_t* consumed) {
+	if(bytes.empty() || bytes[0] != UnsignedBigInt::ENCODING_VERSION) {
+		throw BigNumInvalidEncodingException();
+	}
+	uint64_t n;
+	const size_t header = 1 + read_varint(bytes.subspan(1), n);
+	if(n > (bytes.size() - header) / sizeof(uint64_t)) {
+		throw BigNumInvalidEncodingException();
+	}
+
+	const UnsignedBigIntView ret(bytes.data() + header, n);
+	if(n > 0 && ret.limb(n - 1) == 0) {
+		throw BigNumInvalidEncodingException();
+	}
+	if(consumed) {
+		*consumed = header + n * sizeof(uint64_t);
+	}
+	return ret;
+}
+
+std::strong_ordering UnsignedBigIntView::operator<=>(
+	const UnsignedBigIntView& other) const noexcept {
+	if(m_digits != other.m_digits) {
+		return m_digits <=> other.m_digits;
+	}
+	for(size_t i = m_digits; i > 0; i--) {
+		const uint64_t lhs = limb(i - 1);
+		const uint64_t rhs = other.limb(i - 1);
+		if(lhs != rhs) {
+			return lhs <=> rhs;
+		}
+	}
+	return std::strong_ordering::equal;
+}
+
+bool UnsignedBigIntView::operator==(const UnsignedBigIntView& other) const noexcept {
+	return (*this <=> other) == 0;
+}
+
+UnsignedBigInt& UnsignedBigInt::operator+=(UnsignedBigIntView other) {
+	Workspace::Frame frame(current_workspace());
+	const base_t* b = operand_limbs(other, m_container.data(), m_container.size(), frame);
+	return add_limbs_eq(b, other.digits());
+}
+
+UnsignedBigInt& UnsignedBigInt::operator-=(UnsignedBigIntView other) {
+	Workspace::Frame frame(current_workspace());
+	const base_t* b = operand_limbs(other, m_container.data(), m_container.size(), frame);
+	if(!try_sub_limbs(b, other.digits())) {
+		throw BigNumUnderflowException(*this, UnsignedBigInt(other));
+	}
+	return *this;
+}
+
+UnsignedBigInt& UnsignedBigInt::operator*=(UnsignedBigIntView other) {
+	// the product is formed in scratch, so the operand may overlap this value
+	Workspace::Frame frame(current_workspace());
+	return mul_limbs_eq(operand_limbs(other, nullptr, 0, frame), other.digits());
+}
@@ -0,0 +1,220 @@
+#include "include/thread_pool.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace {
+
+// the pool and deque of the worker running on this thread, null on other threads
+thread_local ThreadPool* worker_pool = nullptr;
+thread_local size_t worker_index = 0;
+
+thread_local ThreadPool* scope_pool = nullptr;
+thread_local size_t scope_grain = ParallelScope::DEFAULT_GRAIN;
+
+} // namespace
+
+// ============================================================================
+// Section: task groups
+// ============================================================================
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool) noexcept
+	: m_pool(pool) { }
+
+ThreadPool::TaskGroup::~TaskGroup() {
+	join();
+}
+
+void ThreadPool::TaskGroup::run(std::function<void()> task) {
+	ThreadPool* pool = scope_pool;
+	const size_t grain = scope_grain;
+	if(pool != nullptr) {
+		task = [pool, grain, inner = std::move(task)]() {
+			ParallelScope scope(*pool, grain);
+			inner();
+		};
+	}
+
+	m_pending.fetch_add(1, std::memory_order_relaxed);
+	try {
+		m_pool.push(Task { std::move(task), this });
+	} catch(...) {
+		m_pending.fetch_sub(1, std::memory_order_relaxed);
+		throw;
+	}
+}
+
+void ThreadPool::TaskGroup::wait() {
+	join();
+	std::exception_ptr error;
+	{
+		std::lock_guard lock(m_error_mutex);
+		std::swap(error, m_error);
+	}
+	if(error) {
+		std::rethrow_exception(error);
+	}
+}
+
+void ThreadPool::TaskGroup::finish(std::exception_ptr error) noexcept {
+	if(error) {
+		std::lock_guard lock(m_error_mutex);
+		if(!m_error) {
+			m_error = std::move(error);
+		}
+	}
+	m_pending.fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::TaskGroup::join() noexcept {
+	// help with whatever is queued instead of blocking. once nothing is left the remaining tasks
+	// of the group are running on other threads and finish without further work from this one
+	while(m_pending.load(std::memory_order_acquire) != 0) {
+		if(!m_pool.run_one()) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+// ============================================================================
+// Section: pool
+// ============================================================================
+ThreadPool::ThreadPool(size_t threads) {
+	if(threads == 0) {
+		threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	// the thread waiting on a group works as well, so one thread fewer is started
+	for(size_t i = 0; i < threads; i++) {
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+	m_workers.reserve(threads - 1);
+	try {
+		for(size_t i = 0; i + 1 < threads; i++) {
+			m_workers.emplace_back([this, i]() { work(i); });
+		}
+	} catch(...) {
+		stop();
+		throw;
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	stop();
+}
+
+size_t ThreadPool::threads() const noexcept {
+	return m_queues.size();
+}
+
+size_t ThreadPool::own_queue() const noexcept {
+	return worker_pool == this ? worker_index : m_queues.size() - 1;
+}
+
+void ThreadPool::push(Task task) {
+	Queue& queue = *m_queues[own_queue()];
+	{
+		std::lock_guard lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+	}
+	m_queued.fetch_add(1, std::memory_order_release);
+
+	// a worker checks m_queued under the sleep mutex before it blocks, so taking the mutex here
+	// orders the notification after that check
+	{
+		std::lock_guard lock(m_sleep_mutex);
+	}
+	m_wake.notify_one();
+}
+
+void ThreadPool::stop() noexcept {
+	{
+		std::lock_guard lock(m_sleep_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for(std::thread& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+}
+
+bool ThreadPool::run_one() {
+	if(m_queued.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+
+	const size_t own = own_queue();
+	std::optional<Task> task;
+	for(size_t i = 0; i < m_queues.size() && !task; i++) {
+		Queue& queue = *m_queues[(own + i) % m_queues.size()];
+		std::lock_guard lock(queue.mutex);
+		if(queue.tasks.empty()) {
+			continue;
+		}
+		if(i == 0) {
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		} else {
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+	}
+	if(!task) {
+		return false;
+	}
+	m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+	// the task is destroyed before the group hears of it, its captures may point into the frame
+	// of the thread waiting on the group
+	std::exception_ptr error;
+	try {
+		std::function<void()> run = std::move(task->run);
+		run();
+	} catch(...) {
+		error = std::current_exception();
+	}
+	task->group->finish(std::move(error));
+	return true;
+}
+
+void ThreadPool::work(size_t index) {
+	worker_pool = this;
+	worker_index = index;
+
+	while(true) {
+		if(run_one()) {
+			continue;
+		}
+
+		std::unique_lock lock(m_sleep_mutex);
+		m_wake.wait(lock, [this]() {
+			return m_stop || m_queued.load(std::memory_order_acquire) != 0;
+		});
+		if(m_stop) {
+			return;
+		}
+	}
+}
+
+// ============================================================================
+// Section: parallel scope
+// ============================================================================
+ParallelScope::ParallelScope(ThreadPool& pool, size_t grain) noexcept
+	: m_previous_pool(scope_pool)
+	, m_previous_grain(scope_grain) {
+	scope_pool = &pool;
+	scope_grain = std::max<size_t>(grain, 1);
+}
+
+ParallelScope::~ParallelScope() {
+	scope_pool = m_previous_pool;
+	scope_grain = m_previous_grain;
+}
+
+ThreadPool* current_pool() noexcept {
+	return scope_pool;
+}
+
+size_t current_grain() noexcept {
+	return scope_grain;
+}
@@ -0,0 +1,145 @@
+#include "include/workspace.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// the thread's own workspace drops chunks beyond this many limbs once idle, so one huge product
+// does not pin its scratch for the rest of the thread
+constexpr size_t RETAINED_LIMBS = 1 << 16;
+
+thread_local Workspace* current = nullptr;
+
+Workspace& thread_workspace() noexcept {
+	thread_local Workspace workspace;
+	return workspace;
+}
+
+size_t round_to_line(size_t limbs) noexcept {
+	return (limbs + 7) & ~size_t(7);
+}
+
+} // namespace
+
+// ============================================================================
+// Section: frames
+// ============================================================================
+Workspace::Frame::Frame(Workspace& workspace) noexcept
+	: m_workspace(workspace)
+	, m_chunk(workspace.m_chunk)
+	, m_offset(workspace.m_offset)
+	, m_used(workspace.m_used) { }
+
+Workspace::Frame::~Frame() {
+	m_workspace.m_chunk = m_chunk;
+	m_workspace.m_offset = m_offset;
+	m_workspace.m_used = m_used;
+
+	if(m_used == 0 && m_workspace.m_capacity > RETAINED_LIMBS &&
+	   &m_workspace == &thread_workspace()) {
+		m_workspace.release();
+	}
+}
+
+uint64_t* Workspace::Frame::take(size_t n) {
+	return m_workspace.take(n);
+}
+
+// ============================================================================
+// Section: workspace
+// ============================================================================
+Workspace::Workspace(size_t limbs) {
+	reserve(limbs);
+}
+
+Workspace::~Workspace() {
+	release();
+}
+
+size_t Workspace::used() const noexcept {
+	return m_used;
+}
+
+size_t Workspace::peak() const noexcept {
+	return m_peak;
+}
+
+void Workspace::reset_peak() noexcept {
+	m_peak = m_used;
+}
+
+size_t Workspace::capacity() const noexcept {
+	return m_capacity;
+}
+
+void Workspace::reserve(size_t limbs) {
+	if(limbs <= m_capacity) {
+		return;
+	}
+	release();
+	add_chunk(round_to_line(limbs));
+}
+
+void Workspace::release() noexcept {
+	for(const Chunk& chunk : m_chunks) {
+		std::free(chunk.data);
+	}
+	m_chunks.clear();
+	m_chunk = 0;
+	m_offset = 0;
+	m_capacity = 0;
+}
+
+void Workspace::add_chunk(size_t limbs) {
+	void* data = std::aligned_alloc(64, limbs * sizeof(uint64_t));
+	if(!data) {
+		throw std::bad_alloc();
+	}
+	m_chunks.push_back({ static_cast<uint64_t*>(data), limbs });
+	m_capacity += limbs;
+}
+
+uint64_t* Workspace::take(size_t n) {
+	n = round_to_line(n);
+
+	// a computation that outgrew the first chunk is served from one chunk next time, which
+	// keeps a workspace sized from peak() on a single allocation
+	if(m_used == 0 && m_chunks.size() > 1) {
+		const size_t capacity = m_capacity;
+		release();
+		add_chunk(capacity);
+	}
+
+	// chunks too small for the request are skipped, the frames restore the position anyway
+	while(m_chunk < m_chunks.size() && m_chunks[m_chunk].size - m_offset < n) {
+		m_chunk++;
+		m_offset = 0;
+	}
+	if(m_chunk == m_chunks.size()) {
+		add_chunk(std::max({ n, m_capacity, MIN_CHUNK }));
+	}
+
+	uint64_t* ret = m_chunks[m_chunk].data + m_offset;
+	m_offset += n;
+	m_used += n;
+	m_peak = std::max(m_peak, m_used);
+	return ret;
+}
+
+// ============================================================================
+// Section: scopes
+// ============================================================================
+WorkspaceScope::WorkspaceScope(Workspace& workspace) noexcept
+	: m_previous(current) {
+	current = &workspace;
+}
+
+WorkspaceScope::~WorkspaceScope() {
+	current = m_previous;
+}
+
+Workspace& current_workspace() noexcept {
+	return current ? *current : thread_workspace();
+}
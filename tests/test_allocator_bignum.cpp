@@ -0,0 +1,120 @@
+#include "include/bignum.hpp"
+#include "include/limb_allocator.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST(LimbAllocator, PoolRecyclesBlocks) {
+	LimbPool& pool = LimbPool::instance();
+	LimbPool::trim();
+
+	void* a = pool.allocate(192);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(a) % 64, 0);
+	pool.deallocate(a, 192);
+
+	// same size class (256 bytes), so the freed block comes straight back
+	void* b = pool.allocate(256);
+	ASSERT_EQ(a, b);
+	pool.deallocate(b, 256);
+
+	void* large = pool.allocate(LimbPool::MAX_BLOCK * 4);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(large) % 64, 0);
+	pool.deallocate(large, LimbPool::MAX_BLOCK * 4);
+	LimbPool::trim();
+}
+
+TEST(LimbAllocator, ArenaBumpsAndReleases) {
+	LimbArena arena;
+	void* a = arena.allocate(128);
+	void* b = arena.allocate(64);
+	ASSERT_EQ(static_cast<char*>(b), static_cast<char*>(a) + 128);
+	ASSERT_EQ(arena.bytes_used(), 192);
+
+	// only the most recent block can be handed back
+	arena.deallocate(a, 128);
+	ASSERT_EQ(arena.bytes_used(), 192);
+	arena.deallocate(b, 64);
+	ASSERT_EQ(arena.bytes_used(), 128);
+
+	void* huge = arena.allocate(LimbArena::MIN_CHUNK * 3);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(huge) % 64, 0);
+	arena.release();
+	ASSERT_EQ(arena.bytes_used(), 0);
+}
+
+TEST(LimbAllocator, ArenaScope) {
+	std::mt19937_64 gen(1);
+	const UnsignedBigInt a = random_bignum(gen, 40);
+	const UnsignedBigInt b = random_bignum(gen, 30);
+	const UnsignedBigInt expected = (a * b + a) % b;
+
+	LimbArena arena;
+	UnsignedBigInt result;
+	{
+		ArenaScope scope(arena);
+		ASSERT_EQ(current_limb_resource(), &arena);
+
+		UnsignedBigInt product = a * b;
+		product += a;
+		// moving into a value from the pool copies the limbs out of the arena
+		result = std::move(product);
+		result %= b;
+	}
+	ASSERT_EQ(current_limb_resource(), &LimbPool::instance());
+	ASSERT_GT(arena.bytes_used(), 0);
+
+	arena.release();
+	ASSERT_TRUE(result == expected);
+}
+
+TEST(LimbAllocator, NestedScopes) {
+	LimbArena outer;
+	LimbArena inner;
+	{
+		ArenaScope outer_scope(outer);
+		{
+			ArenaScope inner_scope(inner);
+			ASSERT_EQ(current_limb_resource(), &inner);
+		}
+		ASSERT_EQ(current_limb_resource(), &outer);
+	}
+	ASSERT_EQ(current_limb_resource(), &LimbPool::instance());
+}
+
+TEST(LimbAllocator, CrossThreadFrees) {
+	// values built on worker threads are destroyed on this one and the other way round
+	std::vector<UnsignedBigInt> values(8);
+	std::vector<std::thread> threads;
+	for(size_t t = 0; t < values.size(); t++) {
+		threads.emplace_back([&values, t] {
+			std::mt19937_64 gen(t);
+			UnsignedBigInt acc = 1;
+			for(int i = 0; i < 200; i++) {
+				acc = (acc * random_bignum(gen, 20)) % random_bignum(gen, 30);
+			}
+			values[t] = std::move(acc);
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+
+	std::mt19937_64 gen(0);
+	UnsignedBigInt expected = 1;
+	for(int i = 0; i < 200; i++) {
+		expected = (expected * random_bignum(gen, 20)) % random_bignum(gen, 30);
+	}
+	ASSERT_TRUE(values[0] == expected);
+
+	std::thread([moved = std::move(values)]() mutable { moved.clear(); }).join();
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
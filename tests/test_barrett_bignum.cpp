@@ -0,0 +1,126 @@
+#include "include/barrett.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+static UnsignedBigInt random_modulus(std::mt19937_64& gen, size_t n) {
+	UnsignedBigInt ret = random_bignum(gen, n);
+	ret.set_bit(64 * n - 1, true);
+	return ret;
+}
+
+/// right to left binary exponentiation with plain divisions as the reference
+static UnsignedBigInt reference_pow(UnsignedBigInt base,
+								   UnsignedBigInt exp,
+								   const UnsignedBigInt& mod) {
+	UnsignedBigInt ret = UnsignedBigInt(1) % mod;
+	base %= mod;
+	while(exp != UnsignedBigInt(0)) {
+		if(exp.get_bit(0)) {
+			ret = (ret * base) % mod;
+		}
+		base = (base * base) % mod;
+		exp >>= 1;
+	}
+	return ret;
+}
+
+TEST(Barrett, Reduce) {
+	std::mt19937_64 gen(1);
+	for(size_t n : { 1, 2, 3, 17, 40, 100, 130 }) {
+		BarrettContext ctx(random_modulus(gen, n));
+		const UnsignedBigInt& mod = ctx.modulus();
+		for(size_t xn : { n - 1, n, n + 1, 2 * n - 1, 2 * n }) {
+			UnsignedBigInt x = random_bignum(gen, xn);
+			ASSERT_TRUE(ctx.reduce(x) == x % mod) << n << " " << xn;
+		}
+
+		// the largest input below m^2 needs the most corrections
+		UnsignedBigInt x = mod.square() - 1;
+		ASSERT_TRUE(ctx.reduce(x) == x % mod) << n;
+	}
+}
+
+TEST(Barrett, LongInputFallsBack) {
+	std::mt19937_64 gen(2);
+	BarrettContext ctx(random_modulus(gen, 4));
+	UnsignedBigInt x = random_bignum(gen, 20);
+	ASSERT_TRUE(ctx.reduce(x) == x % ctx.modulus());
+}
+
+TEST(Barrett, PowerOfBaseModulus) {
+	// mu = B^(k + 1) has one limb more than for any other k limb modulus
+	for(size_t k : { 1, 2, 5 }) {
+		UnsignedBigInt mod = UnsignedBigInt(1) << (64 * (k - 1));
+		BarrettContext ctx(mod);
+		std::mt19937_64 gen(k);
+		UnsignedBigInt x = random_bignum(gen, 2 * k);
+		ASSERT_TRUE(ctx.reduce(x) == x % mod) << k;
+	}
+}
+
+TEST(Barrett, Batch) {
+	std::mt19937_64 gen(3);
+	BarrettContext ctx(random_modulus(gen, 8));
+	std::vector<UnsignedBigInt> values;
+	for(size_t n : { 1, 7, 8, 9, 15, 16, 30 }) {
+		values.push_back(random_bignum(gen, n));
+	}
+
+	std::vector<UnsignedBigInt> expected;
+	for(const UnsignedBigInt& x : values) {
+		expected.push_back(x % ctx.modulus());
+	}
+
+	ctx.reduce_batch(values);
+	for(size_t i = 0; i < values.size(); i++) {
+		ASSERT_TRUE(values[i] == expected[i]) << i;
+	}
+}
+
+TEST(Barrett, MulAndSqr) {
+	std::mt19937_64 gen(4);
+	for(size_t n : { 1, 2, 33, 64 }) {
+		BarrettContext ctx(random_modulus(gen, n));
+		const UnsignedBigInt& mod = ctx.modulus();
+		UnsignedBigInt a = random_bignum(gen, n) % mod;
+		UnsignedBigInt b = random_bignum(gen, n) % mod;
+		ASSERT_TRUE(ctx.mul(a, b) == (a * b) % mod) << n;
+		ASSERT_TRUE(ctx.sqr(a) == a.square() % mod) << n;
+	}
+}
+
+TEST(Barrett, Pow) {
+	std::mt19937_64 gen(5);
+	for(size_t n : { 1, 3, 8 }) {
+		UnsignedBigInt mod = random_modulus(gen, n);
+		mod.set_bit(0, false);
+		BarrettContext ctx(mod);
+		UnsignedBigInt base = random_bignum(gen, n + 1);
+		UnsignedBigInt exp = random_bignum(gen, 2);
+		ASSERT_TRUE(ctx.pow(base, exp) == reference_pow(base, exp, mod)) << n;
+		ASSERT_TRUE(base.modulus_exp(exp, mod) == reference_pow(base, exp, mod)) << n;
+	}
+}
+
+TEST(Barrett, SmallModuli) {
+	BarrettContext one(1);
+	ASSERT_EQ(one.reduce(12345).to_string(), "0");
+	ASSERT_EQ(one.pow(7, 0).to_string(), "0");
+
+	BarrettContext ten(10);
+	ASSERT_EQ(ten.reduce(12345).to_string(), "5");
+	ASSERT_EQ(ten.pow(7, 0).to_string(), "1");
+	ASSERT_EQ(ten.pow(7, 3).to_string(), "3");
+}
+
+TEST(Barrett, ZeroModulus) {
+	ASSERT_THROW(BarrettContext(0), BigNumDivideByZeroException);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
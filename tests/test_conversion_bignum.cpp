@@ -0,0 +1,270 @@
+#include "include/bignum.hpp"
+#include "include/radix_cache.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief horner's rule one digit at a time, the slow reference for the parser
+static UnsignedBigInt parse_reference(const std::string& digits) {
+	UnsignedBigInt ret = 0;
+	for(char digit : digits) {
+		ret *= uint64_t(10);
+		ret += uint64_t(digit - '0');
+	}
+	return ret;
+}
+
+static UnsignedBigInt power_of_ten(size_t n) {
+	UnsignedBigInt ret = 1;
+	for(size_t i = 0; i < n; i++) {
+		ret *= uint64_t(10);
+	}
+	return ret;
+}
+
+TEST(Parse, MatchesReference) {
+	std::mt19937_64 gen(1);
+	// around the leaf width, the recursion threshold and the split points 19 * 2^k
+	for(size_t n : { 1, 7, 8, 9, 16, 18, 19, 20, 38, 39, 100, 1199, 1200, 1201, 1216, 1217,
+					 2432, 2433, 5000, 9729, 20000 }) {
+		const std::string digits = random_digits(gen, n);
+		ASSERT_TRUE(UnsignedBigInt(digits) == parse_reference(digits)) << n;
+	}
+}
+
+TEST(Parse, PowersOfTenAndNines) {
+	for(size_t n : { 18, 19, 20, 1300, 2433, 10000 }) {
+		const UnsignedBigInt power = power_of_ten(n);
+		ASSERT_TRUE(UnsignedBigInt("1" + std::string(n, '0')) == power) << n;
+		ASSERT_TRUE(UnsignedBigInt(std::string(n, '9')) == power - 1) << n;
+	}
+}
+
+TEST(Parse, LeadingZeros) {
+	std::mt19937_64 gen(2);
+	for(size_t zeros : { 1, 19, 3000 }) {
+		const std::string digits = random_digits(gen, 2500);
+		ASSERT_TRUE(UnsignedBigInt(std::string(zeros, '0') + digits) == UnsignedBigInt(digits))
+			<< zeros;
+	}
+	ASSERT_TRUE(UnsignedBigInt(std::string(5000, '0')) == UnsignedBigInt(0));
+	ASSERT_TRUE(UnsignedBigInt("") == UnsignedBigInt(0));
+}
+
+TEST(Parse, RejectsNonDigits) {
+	std::mt19937_64 gen(3);
+	for(size_t n : { 5, 19, 3000 }) {
+		// a bad character in the eight digit blocks and in the trailing single digits
+		for(size_t position : { size_t(0), size_t(3), n / 2, n - 1 }) {
+			for(char bad : { ' ', '/', ':', 'a', '-', '\0' }) {
+				std::string digits = random_digits(gen, n);
+				digits[position] = bad;
+				ASSERT_THROW(UnsignedBigInt{ digits }, BigNumInvalidDigitException)
+					<< n << " " << position << " " << int(bad);
+			}
+		}
+	}
+}
+
+TEST(Format, RoundTrips) {
+	std::mt19937_64 gen(4);
+	// around the leaf width, the recursion threshold and the split points 19 * 2^k
+	for(size_t n : { 1, 18, 19, 20, 39, 700, 771, 772, 800, 1217, 2433, 5000, 20000, 100000 }) {
+		const std::string digits = random_digits(gen, n);
+		ASSERT_EQ(UnsignedBigInt(digits).to_string(), digits) << n;
+	}
+}
+
+TEST(Format, MatchesReference) {
+	std::mt19937_64 gen(5);
+	for(size_t n : { 100, 1500, 6000 }) {
+		const std::string digits = random_digits(gen, n);
+		ASSERT_EQ(parse_reference(digits).to_string(), digits) << n;
+	}
+}
+
+TEST(Format, ZeroBlocksAndPowers) {
+	for(size_t n : { 19, 38, 760, 761, 2432, 2433, 10000 }) {
+		// 10^n and 10^n - 1, and a value whose middle blocks are all zero
+		ASSERT_EQ(power_of_ten(n).to_string(), "1" + std::string(n, '0')) << n;
+		ASSERT_EQ((power_of_ten(n) - 1).to_string(), std::string(n, '9')) << n;
+		const std::string sparse = "3" + std::string(n, '0') + "5";
+		ASSERT_EQ(UnsignedBigInt(sparse).to_string(), sparse) << n;
+	}
+	ASSERT_EQ(UnsignedBigInt(0).to_string(), "0");
+}
+
+constexpr char DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/// @brief horner's rule in any base, the slow reference for from_string and to_string
+static UnsignedBigInt parse_reference(const std::string& digits, unsigned base) {
+	UnsignedBigInt ret = 0;
+	for(char digit : digits) {
+		ret *= uint64_t(base);
+		ret += uint64_t(digit <= '9' ? digit - '0' : digit - 'a' + 10);
+	}
+	return ret;
+}
+
+TEST(Radix, RoundTripsEveryBase) {
+	std::mt19937_64 gen(8);
+	for(unsigned base = 2; base <= 36; base++) {
+		for(size_t limbs : { 1, 2, 7, 40, 300 }) {
+			const UnsignedBigInt value = random_bignum(gen, limbs);
+			const std::string digits = value.to_string(base);
+			ASSERT_NE(digits[0], '0') << base << " " << limbs;
+			ASSERT_TRUE(UnsignedBigInt::from_string(digits, base) == value) << base << " " << limbs;
+			if(limbs <= 40) {
+				ASSERT_TRUE(parse_reference(digits, base) == value) << base << " " << limbs;
+			}
+		}
+	}
+}
+
+TEST(Radix, DivideAndConquerBases) {
+	// past both recursion thresholds, with leaves of 12 to 40 digits
+	std::mt19937_64 gen(9);
+	for(unsigned base : { 3, 7, 10, 12, 36 }) {
+		for(size_t limbs : { 100, 3000 }) {
+			const UnsignedBigInt value = random_bignum(gen, limbs);
+			const std::string digits = value.to_string(base);
+			ASSERT_TRUE(UnsignedBigInt::from_string(digits, base) == value) << base << " " << limbs;
+			ASSERT_TRUE(UnsignedBigInt::from_string("00" + digits, base) == value) << base;
+		}
+		const UnsignedBigInt power = parse_reference("1" + std::string(2000, '0'), base);
+		ASSERT_EQ(power.to_string(base), "1" + std::string(2000, '0')) << base;
+		ASSERT_EQ((power - 1).to_string(base), std::string(2000, DIGITS[base - 1])) << base;
+	}
+}
+
+TEST(Radix, PowerOfTwoBases) {
+	const UnsignedBigInt dead_beef = uint64_t(0xdeadbeef);
+	ASSERT_TRUE(UnsignedBigInt::from_string("DEADbeef", 16) == dead_beef);
+	ASSERT_EQ(dead_beef.to_string(16), "deadbeef");
+	ASSERT_EQ((UnsignedBigInt(1) << 64).to_string(16), "1" + std::string(16, '0'));
+	ASSERT_EQ((UnsignedBigInt(1) << 64).to_string(8), "2" + std::string(21, '0'));
+	ASSERT_EQ((UnsignedBigInt(1) << 130).to_string(32), "1" + std::string(26, '0'));
+	ASSERT_EQ(UnsignedBigInt(5).to_string(2), "101");
+	ASSERT_TRUE(UnsignedBigInt::from_string(std::string(1000, '0') + "7", 8) == UnsignedBigInt(7));
+
+	// digits straddling limb boundaries, from the known bits of random limbs
+	std::mt19937_64 gen(10);
+	const UnsignedBigInt value = random_bignum(gen, 50);
+	std::string bits = value.to_bitstring();
+	std::erase(bits, ' ');
+	bits.erase(0, bits.find('1'));
+	ASSERT_EQ(value.to_string(2), bits);
+	for(unsigned base : { 4, 8, 16, 32 }) {
+		ASSERT_TRUE(parse_reference(value.to_string(base), base) == value) << base;
+	}
+}
+
+TEST(Radix, RejectsBadDigitsAndBases) {
+	ASSERT_THROW(UnsignedBigInt::from_string("102", 2), BigNumInvalidDigitException);
+	ASSERT_THROW(UnsignedBigInt::from_string("1fg", 16), BigNumInvalidDigitException);
+	ASSERT_THROW(UnsignedBigInt::from_string("1z", 35), BigNumInvalidDigitException);
+	ASSERT_THROW(UnsignedBigInt::from_string("-1", 36), BigNumInvalidDigitException);
+	ASSERT_THROW(UnsignedBigInt::from_string("1", 1), BigNumInvalidBaseException);
+	ASSERT_THROW(UnsignedBigInt::from_string("1", 37), BigNumInvalidBaseException);
+	ASSERT_THROW(UnsignedBigInt(7).to_string(0), BigNumInvalidBaseException);
+	ASSERT_TRUE(UnsignedBigInt::from_string("", 16) == UnsignedBigInt(0));
+	ASSERT_EQ(UnsignedBigInt(0).to_string(16), "0");
+}
+
+TEST(RadixCache, Leaves) {
+	ASSERT_EQ(radix_cache::leaf_digits(10), 19);
+	ASSERT_EQ(radix_cache::leaf_base(10), 10000000000000000000ull);
+	ASSERT_EQ(radix_cache::leaf_digits(2), 63);
+	ASSERT_EQ(radix_cache::leaf_digits(16), 15);
+	ASSERT_EQ(radix_cache::leaf_digits(36), 12);
+	ASSERT_EQ(radix_cache::levels(10, 19), 0);
+	ASSERT_EQ(radix_cache::levels(10, 20), 1);
+	ASSERT_EQ(radix_cache::levels(10, 39), 2);
+}
+
+TEST(RadixCache, LevelsAreSquares) {
+	radix_cache::clear();
+	for(unsigned base : { 3, 10, 36 }) {
+		const radix_cache::Powers powers = radix_cache::get(base, 5000);
+		ASSERT_EQ(powers.size(), radix_cache::levels(base, 5000));
+		UnsignedBigInt expected = radix_cache::leaf_base(base);
+		for(size_t k = 0; k < powers.size(); k++) {
+			ASSERT_TRUE(powers[k] == expected) << base << " " << k;
+			expected = expected.square();
+		}
+	}
+	ASSERT_GT(radix_cache::memory_usage(), 0);
+}
+
+TEST(RadixCache, ClearKeepsHeldLevels) {
+	radix_cache::reserve(10, 20000);
+	const radix_cache::Powers held = radix_cache::get(10, 20000);
+	const UnsignedBigInt top = held[held.size() - 1];
+	radix_cache::clear();
+	ASSERT_EQ(radix_cache::memory_usage(), 0);
+	ASSERT_TRUE(held[held.size() - 1] == top);
+	ASSERT_TRUE(radix_cache::get(10, 20000)[held.size() - 1] == top);
+}
+
+TEST(RadixCache, MemoryLimit) {
+	const size_t limit = radix_cache::memory_limit();
+	radix_cache::clear();
+	radix_cache::set_memory_limit(1024);
+
+	// the levels past the limit are computed per call and the conversions stay exact
+	std::mt19937_64 gen(6);
+	const std::string digits = random_digits(gen, 30000);
+	ASSERT_EQ(UnsignedBigInt(digits).to_string(), digits);
+	ASSERT_LE(radix_cache::memory_usage(), 1024);
+	const radix_cache::Powers powers = radix_cache::get(10, 30000);
+	ASSERT_EQ(powers.size(), radix_cache::levels(10, 30000));
+	ASSERT_TRUE(powers[powers.size() - 1] == powers[powers.size() - 2].square());
+
+	radix_cache::set_memory_limit(0);
+	radix_cache::clear();
+	ASSERT_EQ(UnsignedBigInt(digits).to_string(), digits);
+	ASSERT_EQ(radix_cache::memory_usage(), 0);
+	radix_cache::set_memory_limit(limit);
+}
+
+TEST(RadixCache, ConcurrentConversions) {
+	// threads extend the same table at once while another one keeps clearing it
+	std::mt19937_64 gen(7);
+	std::vector<std::string> inputs;
+	for(size_t n : { 1500, 4000, 9000, 17000 }) {
+		inputs.push_back(random_digits(gen, n));
+	}
+	std::atomic<size_t> matches = 0;
+	std::atomic<bool> done = false;
+	std::thread clearer([&]() {
+		while(!done) {
+			radix_cache::clear();
+			std::this_thread::yield();
+		}
+	});
+	std::vector<std::thread> threads;
+	for(size_t i = 0; i < 4; i++) {
+		threads.emplace_back([&, i]() {
+			for(size_t j = 0; j < inputs.size(); j++) {
+				const std::string& digits = inputs[(i + j) % inputs.size()];
+				matches += UnsignedBigInt(digits).to_string() == digits;
+			}
+		});
+	}
+	for(std::thread& thread : threads) {
+		thread.join();
+	}
+	done = true;
+	clearer.join();
+	ASSERT_EQ(matches, 4 * inputs.size());
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,75 @@
+#include "include/bignum.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+static void check_divmod(const UnsignedBigInt& a, const UnsignedBigInt& b) {
+	auto [q, r] = a.divmod(b);
+	ASSERT_TRUE(r < b) << a.digits() << "/" << b.digits();
+	ASSERT_TRUE(q * b + r == a) << a.digits() << "/" << b.digits();
+	ASSERT_TRUE(a / b == q);
+	ASSERT_TRUE(a % b == r);
+}
+
+TEST(DivMod, Random) {
+	std::mt19937_64 gen(42);
+	for(size_t an : { 1, 2, 3, 8, 40, 100 }) {
+		for(size_t bn : { 1, 2, 3, 7, 40, 100 }) {
+			if(bn <= an) {
+				check_divmod(random_bignum(gen, an), random_bignum(gen, bn));
+			}
+		}
+	}
+}
+
+TEST(DivMod, NormalizedDivisor) {
+	// divisors with the top bit already set skip the normalizing shift
+	std::mt19937_64 gen(7);
+	for(size_t bn : { 2, 5, 30 }) {
+		UnsignedBigInt b = random_bignum(gen, bn);
+		b.set_bit(64 * bn - 1, true);
+		check_divmod(random_bignum(gen, 2 * bn + 1), b);
+	}
+}
+
+TEST(DivMod, QuotientCorrections) {
+	// near B^k numerators over divisors just above B^(k-1) / 2 stress the qhat estimate and
+	// the add back step
+	const uint64_t max = std::numeric_limits<uint64_t>::max();
+	check_divmod(from_limbs({ max, max, max, max }), from_limbs({ 1, 0x8000000000000000ull }));
+	check_divmod(from_limbs({ 0, 0, max, 0x7FFFFFFFFFFFFFFFull }),
+				 from_limbs({ max, 0x8000000000000000ull }));
+	check_divmod(from_limbs({ 0, 0, 0, 0x8000000000000000ull }),
+				 from_limbs({ 1, 0, 0x8000000000000000ull }));
+	check_divmod(from_limbs({ 3, 0, 0x8000000000000000ull, 0x7FFFFFFFFFFFFFFFull }),
+				 from_limbs({ 1, 0, 0x8000000000000000ull }));
+	check_divmod(from_limbs({ max, max, max, max, max }), from_limbs({ max, max, 1 }));
+}
+
+TEST(DivMod, SmallCases) {
+	UnsignedBigInt a = std::string("123456789012345678901234567890");
+	auto [q, r] = a.divmod(UnsignedBigInt(std::string("987654321")));
+	ASSERT_EQ(q.to_string(), "124999998873437499901");
+	ASSERT_EQ(r.to_string(), "574845669");
+
+	auto [q2, r2] = UnsignedBigInt(5).divmod(UnsignedBigInt(7));
+	ASSERT_EQ(q2.to_string(), "0");
+	ASSERT_EQ(r2.to_string(), "5");
+
+	auto [q3, r3] = a.divmod(a);
+	ASSERT_EQ(q3.to_string(), "1");
+	ASSERT_EQ(r3.to_string(), "0");
+	ASSERT_EQ(r3.digits(), 1);
+}
+
+TEST(DivMod, DivideByZero) {
+	UnsignedBigInt a = 10;
+	ASSERT_THROW(a.divmod(UnsignedBigInt(0)), BigNumDivideByZeroException);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
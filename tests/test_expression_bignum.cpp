@@ -0,0 +1,137 @@
+#include "include/bignum.hpp"
+#include "include/expression.tpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+
+using bignum_expr::lazy;
+
+TEST(Expression, AddMul) {
+	std::mt19937_64 gen(1);
+	for(size_t n : { 1, 3, 8, 40 }) {
+		UnsignedBigInt acc = random_bignum(gen, n);
+		const UnsignedBigInt a = random_bignum(gen, 2 * n);
+		const UnsignedBigInt b = random_bignum(gen, n);
+		const UnsignedBigInt expected = acc + a * b;
+
+		acc.addmul_eq(a, b);
+		ASSERT_TRUE(acc == expected) << n;
+		acc.addmul_eq(b, UnsignedBigInt(0));
+		ASSERT_TRUE(acc == expected) << n;
+	}
+}
+
+TEST(Expression, AddMulCarriesThroughLongAccumulator) {
+	const UnsignedBigInt max = std::numeric_limits<uint64_t>::max();
+	UnsignedBigInt acc = (UnsignedBigInt(1) << (64 * 20)) - 1;
+	const UnsignedBigInt expected = acc + max * max;
+	acc.addmul_eq(max, max);
+	ASSERT_TRUE(acc == expected);
+}
+
+TEST(Expression, SubMul) {
+	std::mt19937_64 gen(2);
+	for(size_t n : { 1, 3, 8, 40 }) {
+		const UnsignedBigInt a = random_bignum(gen, n);
+		const UnsignedBigInt b = random_bignum(gen, n);
+		const UnsignedBigInt c = random_bignum(gen, n);
+
+		UnsignedBigInt acc = a * b + c;
+		acc.submul_eq(a, b);
+		ASSERT_TRUE(acc == c) << n;
+
+		// too large a product throws and leaves the value untouched
+		ASSERT_THROW(acc.submul_eq(a, b), BigNumUnderflowException) << n;
+		ASSERT_TRUE(acc == c) << n;
+	}
+}
+
+TEST(Expression, SubMulUnderflowRestores) {
+	// product and value have the same length, so the underflow only shows as a final borrow
+	const UnsignedBigInt a = std::numeric_limits<uint64_t>::max();
+	UnsignedBigInt acc = a * a - 1;
+	ASSERT_THROW(acc.submul_eq(a, a), BigNumUnderflowException);
+	ASSERT_TRUE(acc == a * a - 1);
+}
+
+TEST(Expression, AliasedOperands) {
+	UnsignedBigInt a = 12345;
+	a.addmul_eq(a, a);
+	ASSERT_EQ(a.to_string(), "152411370");
+	a.submul_eq(UnsignedBigInt(12345), UnsignedBigInt(12345));
+	ASSERT_EQ(a.to_string(), "12345");
+}
+
+TEST(Expression, Trees) {
+	std::mt19937_64 gen(3);
+	const UnsignedBigInt a = random_bignum(gen, 50);
+	const UnsignedBigInt b = random_bignum(gen, 40);
+	const UnsignedBigInt c = random_bignum(gen, 50);
+	const UnsignedBigInt d = random_bignum(gen, 40);
+	const UnsignedBigInt e = random_bignum(gen, 30);
+	const UnsignedBigInt m = random_bignum(gen, 20);
+
+	ASSERT_TRUE(bignum_expr::eval(lazy(a) * b + lazy(c) * d - e) == a * b + c * d - e);
+	ASSERT_TRUE(bignum_expr::eval(e + lazy(a) * b) == a * b + e);
+	ASSERT_TRUE(bignum_expr::eval(lazy(a) * b - lazy(c)) == a * b - c);
+	ASSERT_TRUE(bignum_expr::eval(lazy(a) * b % m) == (a * b) % m);
+	ASSERT_TRUE(bignum_expr::eval((lazy(a) + b) * (lazy(c) + d)) == (a + b) * (c + d));
+	ASSERT_TRUE(bignum_expr::eval(lazy(a) * b - lazy(e) * e + c) == a * b + c - e * e);
+	ASSERT_TRUE(bignum_expr::eval((lazy(a) * b + lazy(c) * d) % m) == (a * b + c * d) % m);
+}
+
+TEST(Expression, MulMod) {
+	// moduli and quotients on both sides of the burnikel-ziegler threshold, single limb moduli
+	// and products already below the modulus
+	std::mt19937_64 gen(5);
+	for(size_t dn : { 1, 2, 20, 95, 96, 97, 150 }) {
+		const UnsignedBigInt m = random_bignum(gen, dn) + 1;
+		for(size_t an : { size_t(1), dn / 2 + 1, dn, dn + 60, 2 * dn + 100 }) {
+			const UnsignedBigInt a = random_bignum(gen, an);
+			const UnsignedBigInt b = random_bignum(gen, (an + 1) / 2);
+			ASSERT_TRUE(bignum_expr::eval(lazy(a) * b % m) == (a * b) % m) << an << " " << dn;
+			ASSERT_TRUE(bignum_expr::eval(lazy(b) * a % m) == (a * b) % m) << an << " " << dn;
+		}
+	}
+
+	// all ones operands against a modulus with a clear top bit and one without a shift
+	const UnsignedBigInt ones = (UnsignedBigInt(1) << (64 * 120)) - 1;
+	for(const UnsignedBigInt& m : { ones >> 1000, UnsignedBigInt(1) << (64 * 100 - 1) }) {
+		ASSERT_TRUE(bignum_expr::eval(lazy(ones) * ones % m) == (ones * ones) % m);
+	}
+
+	// the operands and the modulus may be the destination itself
+	UnsignedBigInt x = random_bignum(gen, 30);
+	const UnsignedBigInt original = x;
+	const UnsignedBigInt m = random_bignum(gen, 20);
+	x.mulmod_eq(x, m);
+	ASSERT_TRUE(x == (original * original) % m);
+	x = original;
+	x.mulmod_eq(m, x);
+	ASSERT_EQ(x.to_string(), "0");
+	ASSERT_THROW(x.mulmod_eq(m, UnsignedBigInt(0)), BigNumDivideByZeroException);
+}
+
+TEST(Expression, Assign) {
+	std::mt19937_64 gen(4);
+	const UnsignedBigInt a = random_bignum(gen, 10);
+	const UnsignedBigInt b = random_bignum(gen, 10);
+	UnsignedBigInt acc = random_bignum(gen, 30);
+	const UnsignedBigInt original = acc;
+
+	// the destination appears on the right hand side
+	bignum_expr::assign(acc, lazy(a) * b + acc);
+	ASSERT_TRUE(acc == a * b + original);
+	bignum_expr::assign(acc, lazy(acc) - lazy(a) * b);
+	ASSERT_TRUE(acc == original);
+
+	UnsignedBigInt dest = 7;
+	bignum_expr::assign(dest, lazy(a) * b % original);
+	ASSERT_TRUE(dest == (a * b) % original);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,123 @@
+#include "include/bignum.hpp"
+#include "include/ifma.hpp"
+#include "include/montgomery.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/// @brief all ones, the operands with the largest column sums
+static UnsignedBigInt max_bignum(size_t n) {
+	return (UnsignedBigInt(1) << (64 * n)) - 1;
+}
+
+TEST(Ifma, PackRoundTrips) {
+	std::mt19937_64 gen(1);
+	for(size_t n = 1; n <= 20; n++) {
+		std::vector<uint64_t> limbs(n);
+		for(uint64_t& limb : limbs) {
+			limb = gen();
+		}
+		std::vector<uint64_t> packed(ifma::limbs52(n));
+		ifma::pack52(packed.data(), packed.size(), limbs.data(), n);
+		for(uint64_t limb : packed) {
+			ASSERT_LT(limb, uint64_t(1) << 52);
+		}
+
+		std::vector<uint64_t> unpacked(n);
+		ifma::unpack52(unpacked.data(), n, packed.data(), packed.size());
+		ASSERT_EQ(unpacked, limbs) << n;
+	}
+}
+
+TEST(Ifma, ProductsMatchScalar) {
+	if(!ifma::supported()) {
+		GTEST_SKIP() << "the cpu does not run AVX-512 IFMA";
+	}
+
+	std::mt19937_64 gen(2);
+	for(size_t an : { 1, 3, 8, 23, 24, 40, 100, 511, 512, 700 }) {
+		for(size_t bn : { size_t(1), size_t(24), an / 2 + 1, an }) {
+			if(bn > an) {
+				continue;
+			}
+			for(const bool extreme : { false, true }) {
+				const UnsignedBigInt a = extreme ? max_bignum(an) : random_bignum(gen, an);
+				const UnsignedBigInt b = extreme ? max_bignum(bn) : random_bignum(gen, bn);
+
+				UnsignedBigInt expected;
+				UnsignedBigInt expected_square;
+				{
+					ScalarKernels scalar;
+					expected = a * b;
+					expected_square = a.square();
+				}
+				ASSERT_TRUE(a * b == expected) << an << " " << bn;
+				ASSERT_TRUE(a.square() == expected_square) << an;
+			}
+		}
+	}
+}
+
+TEST(Ifma, KernelAtTheColumnBound) {
+	if(!ifma::supported()) {
+		GTEST_SKIP() << "the cpu does not run AVX-512 IFMA";
+	}
+
+	// all ones maximize the column sums, up to the largest shorter operand the kernel takes
+	std::mt19937_64 gen(3);
+	for(size_t bn : { size_t(1), size_t(7), size_t(64), ifma::MAX_MUL_LIMBS }) {
+		const size_t an = 2 * bn + 5;
+		std::vector<uint64_t> a(an, ~uint64_t(0));
+		std::vector<uint64_t> b(bn, ~uint64_t(0));
+		b[0] = gen();
+		std::vector<uint64_t> product(an + bn);
+		ifma::mul(product.data(), a.data(), an, b.data(), bn);
+
+		UnsignedBigInt expected;
+		{
+			ScalarKernels scalar;
+			expected = from_limbs(a) * from_limbs(b);
+		}
+		ASSERT_TRUE(from_limbs(product) == expected) << bn;
+	}
+}
+
+TEST(Ifma, MontgomeryPowMatchesScalar) {
+	if(!ifma::supported()) {
+		GTEST_SKIP() << "the cpu does not run AVX-512 IFMA";
+	}
+
+	std::mt19937_64 gen(4);
+	for(size_t n : { 8, 13, 16, 32, 64 }) {
+		const UnsignedBigInt mod = (random_bignum(gen, n) << 1) + 1;
+		const UnsignedBigInt base = random_bignum(gen, n) % mod;
+		const UnsignedBigInt exp = random_bignum(gen, n);
+
+		UnsignedBigInt expected;
+		{
+			ScalarKernels scalar;
+			expected = MontgomeryContext(mod).pow(base, exp);
+		}
+		const MontgomeryContext context(mod);
+		ASSERT_TRUE(context.pow(base, exp) == expected) << n;
+
+		// bases at the edges of the range, and a modulus whose top limb is all ones
+		ASSERT_TRUE(context.pow(mod - 1, UnsignedBigInt(2)) == UnsignedBigInt(1)) << n;
+		ASSERT_TRUE(context.pow(UnsignedBigInt(0), exp) == UnsignedBigInt(0)) << n;
+		const UnsignedBigInt full = max_bignum(n);
+		UnsignedBigInt full_expected;
+		{
+			ScalarKernels scalar;
+			full_expected = MontgomeryContext(full).pow(base, exp);
+		}
+		ASSERT_TRUE(MontgomeryContext(full).pow(base, exp) == full_expected) << n;
+	}
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
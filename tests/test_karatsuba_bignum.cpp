@@ -0,0 +1,57 @@
+#include "include/bignum.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+TEST(Karatsuba, Balanced) {
+	for(size_t n : { 31, 32, 33, 64, 65, 100, 257 }) {
+		check_product(n, n, n);
+	}
+}
+
+TEST(Karatsuba, Unbalanced) {
+	check_product(33, 32, 1);
+	check_product(100, 40, 2);
+	check_product(300, 64, 3);
+	check_product(129, 33, 4);
+	check_product(500, 5, 5);
+}
+
+TEST(Karatsuba, AllOnes) {
+	// every partial product and middle term carries
+	const size_t n = 150;
+	std::vector<uint64_t> limbs(n, std::numeric_limits<uint64_t>::max());
+	UnsignedBigInt a = from_limbs(limbs);
+	UnsignedBigInt expected = reference_product(a, limbs);
+
+	for_each_kernel_path([&] { ASSERT_TRUE(a * a == expected); });
+}
+
+TEST(Karatsuba, Square) {
+	std::mt19937_64 gen(42);
+	std::vector<uint64_t> limbs = random_limbs(gen, 200);
+	UnsignedBigInt a = from_limbs(limbs);
+	UnsignedBigInt expected = reference_product(a, limbs);
+
+	for_each_kernel_path([&] {
+		UnsignedBigInt b = a;
+		b *= b;
+		ASSERT_TRUE(b == expected);
+	});
+}
+
+TEST(Karatsuba, Zero) {
+	std::mt19937_64 gen(7);
+	UnsignedBigInt a = from_limbs(random_limbs(gen, 80));
+	UnsignedBigInt zero = 0;
+
+	ASSERT_EQ((a * zero).to_string(), "0");
+	ASSERT_EQ((a * zero).digits(), 1);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+#include "include/bignum.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+// reaches the newton kernels, which divmod only picks for operands of 2^19 limbs
+class DivisionKernels {
+public:
+	static std::pair<UnsignedBigInt, UnsignedBigInt> newton(
+		const UnsignedBigInt& a, const UnsignedBigInt& b) {
+		return a.divmod_newton(b);
+	}
+
+	static UnsignedBigInt reciprocal(const UnsignedBigInt& d, size_t t) {
+		return UnsignedBigInt::reciprocal(d, t);
+	}
+};
+
+/// divmod picks schoolbook or burnikel-ziegler at these sizes
+static void check_newton(const UnsignedBigInt& a, const UnsignedBigInt& b) {
+	auto [q, r] = DivisionKernels::newton(a, b);
+	auto [expected_q, expected_r] = a.divmod(b);
+	ASSERT_TRUE(q == expected_q) << a.digits() << "/" << b.digits();
+	ASSERT_TRUE(r == expected_r) << a.digits() << "/" << b.digits();
+}
+
+static void check_divmod(const UnsignedBigInt& a, const UnsignedBigInt& b) {
+	auto [q, r] = a.divmod(b);
+	ASSERT_TRUE(r < b) << a.digits() << "/" << b.digits();
+	ASSERT_TRUE(q * b + r == a) << a.digits() << "/" << b.digits();
+}
+
+TEST(LargeDivision, RecursionEdges) {
+	// divisor and quotient lengths around the recursive threshold, odd splits included
+	std::mt19937_64 gen(5);
+	for(size_t n : { 95, 96, 97, 191, 192, 193, 250 }) {
+		check_divmod(random_bignum(gen, 2 * n), random_bignum(gen, n));
+		check_divmod(random_bignum(gen, 2 * n - 1), random_bignum(gen, n));
+	}
+}
+
+TEST(LargeDivision, RaggedBlocks) {
+	// quotients that are not a whole number of divisor sized blocks
+	std::mt19937_64 gen(6);
+	check_divmod(random_bignum(gen, 500), random_bignum(gen, 100));
+	check_divmod(random_bignum(gen, 700), random_bignum(gen, 130));
+	check_divmod(random_bignum(gen, 400), random_bignum(gen, 250));
+	check_divmod(random_bignum(gen, 350), random_bignum(gen, 250));
+}
+
+TEST(LargeDivision, Balanced) {
+	std::mt19937_64 gen(42);
+	for(size_t n : { 2048, 2049, 3000 }) {
+		check_divmod(random_bignum(gen, 2 * n), random_bignum(gen, n));
+	}
+}
+
+TEST(LargeDivision, LongQuotient) {
+	// the quotient is produced in several blocks
+	std::mt19937_64 gen(1);
+	check_divmod(random_bignum(gen, 7000), random_bignum(gen, 2100));
+}
+
+TEST(LargeDivision, ShortQuotient) {
+	// the top of the quotient comes from the top of the divisor plus a correction
+	std::mt19937_64 gen(2);
+	check_divmod(random_bignum(gen, 6200), random_bignum(gen, 4100));
+}
+
+TEST(LargeDivision, AllOnes) {
+	const uint64_t max = std::numeric_limits<uint64_t>::max();
+	UnsignedBigInt a = from_limbs(std::vector<uint64_t>(5000, max));
+	UnsignedBigInt b = from_limbs(std::vector<uint64_t>(2500, max));
+	check_divmod(a, b);
+	check_divmod(a, b + 1);
+	check_divmod(a, b - 1);
+
+	// exact division leaves no remainder
+	std::mt19937_64 gen(3);
+	UnsignedBigInt c = random_bignum(gen, 2200);
+	auto [q, r] = (b * c).divmod(b);
+	ASSERT_TRUE(q == c);
+	ASSERT_EQ(r.to_string(), "0");
+}
+
+TEST(LargeDivision, Operators) {
+	std::mt19937_64 gen(4);
+	UnsignedBigInt a = random_bignum(gen, 4500);
+	UnsignedBigInt b = random_bignum(gen, 2200);
+	auto [q, r] = a.divmod(b);
+	ASSERT_TRUE(a / b == q);
+	ASSERT_TRUE(a % b == r);
+}
+
+TEST(LargeDivision, NewtonReciprocal) {
+	// B^(2t) / dt - 2 <= x <= B^(2t) / dt at and past the base case, for random and all ones
+	// divisors
+	std::mt19937_64 gen(7);
+	const uint64_t max = std::numeric_limits<uint64_t>::max();
+	for(size_t t : { 31, 32, 33, 64, 65, 200 }) {
+		std::vector<uint64_t> limbs(t + 3);
+		for(auto& limb : limbs) {
+			limb = gen();
+		}
+		limbs.back() |= 1ull << 63;
+		for(const UnsignedBigInt& d : { from_limbs(limbs), from_limbs(std::vector(t + 3, max)) }) {
+			const UnsignedBigInt dt = (d >> (64 * 3)) + 1;
+			const UnsignedBigInt bound = (UnsignedBigInt(1) << (128 * t)) / dt;
+			const UnsignedBigInt x = DivisionKernels::reciprocal(d, t);
+			ASSERT_TRUE(x <= bound) << t;
+			ASSERT_TRUE(x + 2 >= bound) << t;
+		}
+	}
+}
+
+TEST(LargeDivision, NewtonMatchesLongDivision) {
+	// divisors past the reciprocal base case, with quotients as long as the divisor, one limb
+	// longer or shorter, in several blocks, and too short for a newton step
+	std::mt19937_64 gen(8);
+	for(size_t dn : { 33, 64, 97, 250, 700 }) {
+		const UnsignedBigInt d = random_bignum(gen, dn);
+		for(size_t qn : { dn, dn + 1, dn - 1, 3 * dn + 5, size_t(5) }) {
+			check_newton(random_bignum(gen, dn + qn - 1), d);
+			check_newton(random_bignum(gen, dn + qn), d);
+		}
+	}
+}
+
+TEST(LargeDivision, NewtonAllOnes) {
+	// all ones operands push every quotient estimate to its largest correction
+	const uint64_t max = std::numeric_limits<uint64_t>::max();
+	for(size_t dn : { 33, 100, 300 }) {
+		const UnsignedBigInt d = from_limbs(std::vector<uint64_t>(dn, max));
+		for(size_t nn : { 2 * dn - 2, 2 * dn - 1, 2 * dn, 2 * dn + 1, 4 * dn }) {
+			const UnsignedBigInt a = from_limbs(std::vector<uint64_t>(nn, max));
+			check_newton(a, d);
+			check_newton(a, d - 1);
+			check_newton(a - 1, d);
+		}
+		// a top limb of exactly 2^63 keeps the normalizing shift at zero
+		const UnsignedBigInt power = UnsignedBigInt(1) << (64 * dn - 1);
+		check_newton(from_limbs(std::vector<uint64_t>(3 * dn, max)), power);
+	}
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+#include "include/bignum.hpp"
+#include "include/limbs.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using limbs::limb_t;
+
+/// @brief random limbs biased toward all ones and zeros, where carries run the longest
+static std::vector<limb_t> random_limbs(std::mt19937_64& gen, size_t n) {
+	std::vector<limb_t> ret(n);
+	for(limb_t& limb : ret) {
+		switch(gen() % 4) {
+		case 0:
+			limb = ~0ull;
+			break;
+		case 1:
+			limb = 0;
+			break;
+		default:
+			limb = gen();
+		}
+	}
+	return ret;
+}
+
+TEST(Limbs, AddSubMatchPortable) {
+	std::mt19937_64 gen(1);
+	for(size_t n = 0; n <= 40; n++) {
+		for(int round = 0; round < 20; round++) {
+			const std::vector<limb_t> a = random_limbs(gen, n);
+			const std::vector<limb_t> b = random_limbs(gen, n);
+			std::vector<limb_t> expected(n), actual(n);
+
+			limb_t carry = limbs::portable::add_n(expected.data(), a.data(), b.data(), n);
+			ASSERT_EQ(limbs::kernels.add_n(actual.data(), a.data(), b.data(), n), carry) << n;
+			ASSERT_EQ(actual, expected) << n;
+
+			carry = limbs::portable::sub_n(expected.data(), a.data(), b.data(), n);
+			ASSERT_EQ(limbs::kernels.sub_n(actual.data(), a.data(), b.data(), n), carry) << n;
+			ASSERT_EQ(actual, expected) << n;
+
+			// in place, on either operand
+			actual = a;
+			ASSERT_EQ(limbs::kernels.sub_n(actual.data(), actual.data(), b.data(), n), carry);
+			ASSERT_EQ(actual, expected) << n;
+			actual = b;
+			ASSERT_EQ(limbs::kernels.sub_n(actual.data(), a.data(), actual.data(), n), carry);
+			ASSERT_EQ(actual, expected) << n;
+		}
+	}
+}
+
+TEST(Limbs, MulMatchPortable) {
+	std::mt19937_64 gen(2);
+	for(size_t n = 0; n <= 40; n++) {
+		for(int round = 0; round < 20; round++) {
+			const std::vector<limb_t> a = random_limbs(gen, n);
+			const std::vector<limb_t> out = random_limbs(gen, n);
+			const limb_t b = round == 0 ? ~0ull : gen();
+			std::vector<limb_t> expected(n), actual(n);
+
+			limb_t carry = limbs::portable::mul_1(expected.data(), a.data(), n, b);
+			ASSERT_EQ(limbs::kernels.mul_1(actual.data(), a.data(), n, b), carry) << n;
+			ASSERT_EQ(actual, expected) << n;
+			actual = a;
+			ASSERT_EQ(limbs::kernels.mul_1(actual.data(), actual.data(), n, b), carry) << n;
+			ASSERT_EQ(actual, expected) << n;
+
+			expected = actual = out;
+			carry = limbs::portable::addmul_1(expected.data(), a.data(), n, b);
+			ASSERT_EQ(limbs::kernels.addmul_1(actual.data(), a.data(), n, b), carry) << n;
+			ASSERT_EQ(actual, expected) << n;
+
+			expected = actual = out;
+			carry = limbs::portable::submul_1(expected.data(), a.data(), n, b);
+			ASSERT_EQ(limbs::kernels.submul_1(actual.data(), a.data(), n, b), carry) << n;
+			ASSERT_EQ(actual, expected) << n;
+		}
+	}
+}
+
+TEST(Limbs, SpansStopCarryingEarly) {
+	// a carry or borrow running off the end of the shorter operand ripples through the rest
+	const std::vector<limb_t> ones(9, ~0ull);
+	const limb_t one = 1;
+	std::vector<limb_t> sum(9);
+	ASSERT_EQ(limbs::add(sum.data(), ones.data(), 9, &one, 1), 1);
+	ASSERT_EQ(sum, std::vector<limb_t>(9, 0));
+	ASSERT_EQ(limbs::sub(sum.data(), sum.data(), 9, &one, 1), 1);
+	ASSERT_EQ(sum, ones);
+
+	// out of place the untouched high limbs are still copied over
+	std::vector<limb_t> a(9, 5);
+	std::vector<limb_t> diff(9);
+	ASSERT_EQ(limbs::sub(diff.data(), a.data(), 9, &one, 1), 0);
+	a[0] = 4;
+	ASSERT_EQ(diff, a);
+}
+
+TEST(Limbs, SingleLimbOperations) {
+	// the single limb operators run on the same kernels
+	UnsignedBigInt x(std::string("340282366920938463463374607431768211455")); // 2^128 - 1
+	x += 1;
+	ASSERT_EQ(x.to_string(), "340282366920938463463374607431768211456");
+	x *= ~0ull;
+	ASSERT_EQ(x.to_string(), "6277101735386680763495507056286727952638980837032266301440");
+	x *= 0;
+	x += 7;
+	ASSERT_EQ(x.to_string(), "7");
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
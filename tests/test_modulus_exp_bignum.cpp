@@ -43,6 +43,69 @@ TEST(ModPower, Hard) {
 	ASSERT_EQ(c.to_string(), ans.to_string());
 }
 
+TEST(ModPower, LargeExponent) {
+	// 2048 bit exponent, far out of reach of anything linear in its value
+	UnsignedBigInt a = std::string(
+		"674812844650248678141351805755508987247294837340352398577467495394282140389469873145297507"
+		"945268607247266738344787910497404933707614101205532247602527114138163696024526693443189418"
+		"268366717365938198650428574531586873699576546158843247385874945620611984915168581001414181"
+		"8532483261516098950821960922168");
+	UnsignedBigInt exp = std::string(
+		"111001058864982549416145586844061261073510534546530954494449597853280005970331694976509737"
+		"037821034516489144179068079817809678094965221051733093847372973752475556634918175708143291"
+		"847066460286098973549218398142166992166167766022215726096282772656616617034100613138370291"
+		"714144476271380100424627751179142964624204205980840085160147727939965691130851912300301779"
+		"062023748061111076457904322884769988106637303350715923822897406877526822702326786064135571"
+		"034069684324190940187316310382511022059602500980744708751928884358124887331844916852595049"
+		"32232420445152925259575235303516219141272966075739322886290563098432749139637");
+	UnsignedBigInt mod = std::string(
+		"276460388525347430784806043299711911441675410080606833881069684023633342069334547412297645"
+		"350973744940350639672676396574319576789905354947140292684389649600562632499075870815106961"
+		"350531309035381262494320727706667284123309500818835755076788302729776056845478352082197240"
+		"992920169590872001530576688663726296382797349053818794783627926300525386688897818509271784"
+		"624895383791894169949420171286585333930776934068846409779680940008565023238310245081314862"
+		"355577011182322642732824147648762260150928748502067447877795255620337823868110562142471304"
+		"75033739476525007114764074424100569204696062439981271889973599514982258371872");
+
+	ASSERT_EQ(a.modulus_exp(exp, mod).to_string(),
+			  "12887381107182651435885219782045503502405707736081805464859020885959145895409376"
+			  "29940220346953964177378854066538390406879757662987120796145673827319380079783941"
+			  "81573291797760555430387102787445499495173749861345349178036940471672264568811291"
+			  "68713103124797362058737535825376836524587773151570505839223273243007268630739979"
+			  "66568965515592088464087559675481351155463676266465796241798083332343846052636168"
+			  "96726115840402421827804831391311558371054759939296084887148091916447657114351834"
+			  "68848456934548578856643635678619703802843949505997998865441425128629245181424351"
+			  "46361866657291200636899493272627912660125733938157116224");
+	ASSERT_EQ(a.modulus_exp(exp, mod + 1).to_string(),
+			  "16985815734556122929571672887732994113314689711516519620138472631729697505020250"
+			  "92846208176921866807512734168462460339645761556322366355088515673224217986204177"
+			  "24334611206146176806184155468873244281169811568229562919121877904959997853034003"
+			  "79684369915282240177624128291073290679178232587677818995578477401358487307122803"
+			  "77476284010263453414570120613994404603634764408367774759981473694513946310254339"
+			  "51488986198944367547115602496660090247972901098796424508863406302749832844288214"
+			  "28422237300426992067809870000511394921680185901483368465434105275594713323217728"
+			  "50456823254650651935241785749439088851167447908200221009");
+}
+
+TEST(ModPower, WindowSizes) {
+	// every window width against plain binary exponentiation
+	UnsignedBigInt base = std::string("123456789123456789123456789123456789");
+	UnsignedBigInt mod = std::string("987654321987654321987654321987654321987654321");
+	for(size_t bits : { 1, 5, 24, 30, 80, 100, 240, 300, 672, 800 }) {
+		UnsignedBigInt exp = UnsignedBigInt(1) << (bits - 1);
+		exp += bits > 32 ? 0x5A5A5A5Bull : 1;
+
+		UnsignedBigInt expected = 1;
+		for(size_t i = exp.most_significant_bit(); i > 0; i--) {
+			expected = expected.square() % mod;
+			if(exp.get_bit(i - 1)) {
+				expected = (expected * base) % mod;
+			}
+		}
+		ASSERT_EQ(base.modulus_exp(exp, mod).to_string(), expected.to_string()) << bits;
+	}
+}
+
 int main(int argc, char** argv) {
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
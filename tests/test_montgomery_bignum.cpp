@@ -0,0 +1,95 @@
+#include "include/montgomery.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+static UnsignedBigInt random_odd_modulus(std::mt19937_64& gen, size_t n) {
+	UnsignedBigInt ret = random_bignum(gen, n);
+	ret.set_bit(64 * n - 1, true);
+	ret.set_bit(0, true);
+	return ret;
+}
+
+TEST(Montgomery, RoundTrip) {
+	std::mt19937_64 gen(1);
+	for(size_t n : { 1, 2, 5, 32, 100 }) {
+		MontgomeryContext ctx(random_odd_modulus(gen, n));
+		UnsignedBigInt x = random_bignum(gen, n) % ctx.modulus();
+		ASSERT_TRUE(ctx.from_mont(ctx.to_mont(x)) == x) << n;
+	}
+}
+
+TEST(Montgomery, MulAndSqr) {
+	std::mt19937_64 gen(2);
+	for(size_t n : { 1, 2, 3, 16, 33, 64 }) {
+		MontgomeryContext ctx(random_odd_modulus(gen, n));
+		const UnsignedBigInt& mod = ctx.modulus();
+		UnsignedBigInt a = random_bignum(gen, n) % mod;
+		UnsignedBigInt b = random_bignum(gen, n) % mod;
+
+		UnsignedBigInt product = ctx.from_mont(ctx.mul(ctx.to_mont(a), ctx.to_mont(b)));
+		ASSERT_TRUE(product == (a * b) % mod) << n;
+
+		UnsignedBigInt square = ctx.from_mont(ctx.sqr(ctx.to_mont(a)));
+		ASSERT_TRUE(square == a.square() % mod) << n;
+	}
+}
+
+TEST(Montgomery, AllOnesModulus) {
+	// the largest n limb modulus makes every reduction carry
+	UnsignedBigInt mod = (UnsignedBigInt(1) << 256) - 1;
+	MontgomeryContext ctx(mod);
+	UnsignedBigInt a = mod - 2;
+	ASSERT_TRUE(ctx.from_mont(ctx.sqr(ctx.to_mont(a))) == a.square() % mod);
+	ASSERT_TRUE(ctx.from_mont(ctx.mul(ctx.to_mont(a), ctx.to_mont(a))) == a.square() % mod);
+}
+
+TEST(Montgomery, Pow) {
+	UnsignedBigInt mod = std::string(
+		"107041211026248633124383484260147904672455186482560180488666891280129480749920995780787467"
+		"155193204395683366065254265690194971224395017706624893661933711708036854147532634767031767"
+		"008289449543185697134582240430743329939210323331161335669709651446899978617611810042626943"
+		"325843443933614488286992538366129415533");
+	UnsignedBigInt base = std::string(
+		"248261833877141458344253554854254382315352788448142793028339868208353131775321626854306216"
+		"920017698320872639486385323376084717104942743302360641189063848121105030850573246894853362"
+		"899801341064103805515630498945377690418791380063447280223014977278104348555444245651745187"
+		"286245610608845688023535421178083377282668146345514086164084506158682118651726258561882734"
+		"889591336616989090440634828769020193216139815470663635024505545713518516369505578341357996"
+		"04");
+	UnsignedBigInt exp = std::string(
+		"714447093355208307298543465284565942196612940042413226050668116173736325019732625748239739"
+		"504605930764913498173843616731391671047273466438530442464452535960508162774571616262202378"
+		"356445006802076517855583645313023263846607842133631813030530869784448459320173398998399235"
+		"87140744236571686155737320803929541799");
+
+	MontgomeryContext ctx(mod);
+	ASSERT_EQ(ctx.pow(base, exp).to_string(),
+			  "62045947574182715530587068362003525594955546935366897326394744893015992913802347"
+			  "36785568199786387143058123988300302633218370962273916898449823619237629311690454"
+			  "40207135384898974195520766922398823273464026871217417345771348380982026291977301"
+			  "63362949883668599607789721552152671297928200321508745764460625369792");
+	ASSERT_EQ(ctx.pow(base, UnsignedBigInt(0)).to_string(), "1");
+	ASSERT_EQ(base.modulus_exp(exp, mod).to_string(), ctx.pow(base, exp).to_string());
+}
+
+TEST(Montgomery, SmallModuli) {
+	MontgomeryContext one(UnsignedBigInt(1));
+	ASSERT_EQ(one.pow(UnsignedBigInt(5), UnsignedBigInt(3)).to_string(), "0");
+	ASSERT_EQ(one.pow(UnsignedBigInt(5), UnsignedBigInt(0)).to_string(), "0");
+
+	MontgomeryContext ctx(UnsignedBigInt(497));
+	ASSERT_EQ(ctx.pow(UnsignedBigInt(4), UnsignedBigInt(13)).to_string(), "445");
+}
+
+TEST(Montgomery, EvenModulus) {
+	ASSERT_THROW(MontgomeryContext(UnsignedBigInt(10)), BigNumEvenModulusException);
+	ASSERT_THROW(MontgomeryContext(UnsignedBigInt(0)), BigNumEvenModulusException);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,73 @@
+#include "include/bignum.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <utility>
+
+TEST(Move, MovedFromIsZero) {
+	std::mt19937_64 gen(1);
+	for(size_t n : { 1, 4, 40 }) {
+		UnsignedBigInt a = random_bignum(gen, n);
+		const std::string expected = a.to_string();
+
+		UnsignedBigInt b = std::move(a);
+		ASSERT_EQ(b.to_string(), expected);
+		ASSERT_EQ(a.to_string(), "0");
+		ASSERT_EQ(a.digits(), 1);
+
+		// a moved from value is still usable
+		a += 5;
+		ASSERT_EQ(a.to_string(), "5");
+
+		UnsignedBigInt c = 7;
+		c = std::move(b);
+		ASSERT_EQ(c.to_string(), expected);
+		ASSERT_EQ(b.to_string(), "0");
+	}
+}
+
+TEST(Move, SelfMoveAssignment) {
+	UnsignedBigInt a = 12345;
+	UnsignedBigInt& alias = a;
+	a = std::move(alias);
+	ASSERT_EQ(a.to_string(), "12345");
+}
+
+TEST(Move, RvalueOperatorsMatchLvalueOperators) {
+	std::mt19937_64 gen(2);
+	const UnsignedBigInt a = random_bignum(gen, 30);
+	const UnsignedBigInt b = random_bignum(gen, 20);
+	const UnsignedBigInt c = random_bignum(gen, 10);
+
+	// every temporary below picks an rvalue overload
+	ASSERT_TRUE(a * b + c == (a * b) + c);
+	ASSERT_TRUE(c + a * b == (a * b) + c);
+	ASSERT_TRUE(a * b + b * c == (b * c) + (a * b));
+	ASSERT_TRUE(a * (b + c) == a * b + a * c);
+	ASSERT_TRUE((a + b) * (b + c) == a * b + a * c + b * b + b * c);
+	ASSERT_TRUE((a * b - c) + c == a * b);
+	ASSERT_TRUE((a * b) / b == a);
+	ASSERT_TRUE((a * b + c) % b == c % b);
+	ASSERT_TRUE(((a + 1) << 64) >> 64 == a + 1);
+	ASSERT_TRUE((a * 3 - 1) + 1 == a + a + a);
+	ASSERT_TRUE((a + b).square() == (a + b) * (a + b));
+	ASSERT_TRUE(((c + 0) ^ UnsignedBigInt(3)) == c * c * c);
+}
+
+TEST(Move, ExpiringOperandAliasesOther) {
+	std::mt19937_64 gen(3);
+	UnsignedBigInt a = random_bignum(gen, 12);
+	const UnsignedBigInt expected_sum = a + a;
+	const UnsignedBigInt expected_square = a.square();
+
+	UnsignedBigInt x = a;
+	ASSERT_TRUE(std::move(x) + x == expected_sum);
+	UnsignedBigInt y = a;
+	ASSERT_TRUE(y * std::move(y) == expected_square);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,65 @@
+#include "include/bignum.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+
+/// B^n - 1, every limb set: maximizes every convolution coefficient
+static UnsignedBigInt all_ones(size_t limbs) {
+	UnsignedBigInt ret = 1;
+	ret <<= 64 * limbs;
+	ret -= 1;
+	return ret;
+}
+
+TEST(NTT, AllOnesSquare) {
+	const size_t n = 5000;
+	UnsignedBigInt a = all_ones(n);
+
+	// (B^n - 1)^2 = B^2n - 2 B^n + 1
+	UnsignedBigInt expected = UnsignedBigInt(1) << (128 * n);
+	expected -= UnsignedBigInt(1) << (64 * n + 1);
+	expected += 1;
+
+	ASSERT_EQ(a.digits(), n);
+	ASSERT_TRUE(a * a == expected);
+}
+
+TEST(NTT, RandomTimesAllOnes) {
+	std::mt19937_64 gen(1);
+	for(size_t n : { 4096, 4500, 9000 }) {
+		UnsignedBigInt a = random_bignum(gen, n);
+		UnsignedBigInt b = all_ones(n);
+
+		// a * (B^n - 1) = a B^n - a
+		UnsignedBigInt expected = (a << (64 * n)) - a;
+		ASSERT_TRUE(a * b == expected) << n;
+	}
+}
+
+TEST(NTT, Unbalanced) {
+	std::mt19937_64 gen(2);
+	UnsignedBigInt a = random_bignum(gen, 20000);
+	UnsignedBigInt b = all_ones(5000);
+
+	UnsignedBigInt expected = (a << (64 * 5000)) - a;
+	ASSERT_TRUE(a * b == expected);
+	ASSERT_TRUE(b * a == expected);
+}
+
+TEST(NTT, DifferenceOfSquares) {
+	// (a + b)^2 = (a - b)^2 + 4ab
+	std::mt19937_64 gen(3);
+	UnsignedBigInt a = random_bignum(gen, 6000);
+	UnsignedBigInt b = random_bignum(gen, 5000);
+
+	UnsignedBigInt sum = a + b;
+	UnsignedBigInt diff = a - b;
+
+	ASSERT_TRUE(sum * sum == diff * diff + (a * b) * 4);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,128 @@
+#include "include/bignum.hpp"
+#include "include/thread_pool.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <random>
+#include <stdexcept>
+
+/// @brief sum of 1..n, forking both halves down to single numbers
+static void sum_range(ThreadPool& pool, size_t begin, size_t end, std::atomic<size_t>& sum) {
+	if(end - begin == 1) {
+		sum += begin;
+		return;
+	}
+	const size_t mid = begin + (end - begin) / 2;
+	ThreadPool::TaskGroup group(pool);
+	group.run([&pool, mid, end, &sum]() { sum_range(pool, mid, end, sum); });
+	sum_range(pool, begin, mid, sum);
+	group.wait();
+}
+
+TEST(ThreadPool, NestedGroupsRunEveryTask) {
+	for(size_t threads : { 1, 2, 4 }) {
+		ThreadPool pool(threads);
+		ASSERT_EQ(pool.threads(), threads);
+		std::atomic<size_t> sum = 0;
+		sum_range(pool, 1, 10001, sum);
+		ASSERT_EQ(sum, size_t(10000) * 10001 / 2) << threads;
+	}
+}
+
+TEST(ThreadPool, WaitRethrows) {
+	ThreadPool pool(3);
+	ThreadPool::TaskGroup group(pool);
+	std::atomic<size_t> finished = 0;
+	for(size_t i = 0; i < 16; i++) {
+		group.run([i, &finished]() {
+			if(i == 5) {
+				throw std::runtime_error("task failed");
+			}
+			finished++;
+		});
+	}
+	ASSERT_THROW(group.wait(), std::runtime_error);
+	ASSERT_EQ(finished, 15);
+}
+
+TEST(ThreadPool, ScopesNestAndReachTasks) {
+	ThreadPool pool(2);
+	ThreadPool other(2);
+	ASSERT_EQ(current_pool(), nullptr);
+	{
+		ParallelScope outer(pool, 100);
+		{
+			ParallelScope inner(other, 7);
+			ASSERT_EQ(current_pool(), &other);
+			ASSERT_EQ(current_grain(), 7);
+
+			ThreadPool::TaskGroup group(other);
+			ThreadPool* seen_pool = nullptr;
+			size_t seen_grain = 0;
+			group.run([&]() {
+				seen_pool = current_pool();
+				seen_grain = current_grain();
+			});
+			group.wait();
+			ASSERT_EQ(seen_pool, &other);
+			ASSERT_EQ(seen_grain, 7);
+		}
+		ASSERT_EQ(current_pool(), &pool);
+		ASSERT_EQ(current_grain(), 100);
+	}
+	ASSERT_EQ(current_pool(), nullptr);
+}
+
+TEST(ParallelMultiplication, MatchesSerial) {
+	std::mt19937_64 gen(1);
+	ThreadPool pool(4);
+	// karatsuba and toom-3, which the IFMA kernel replaces where the cpu runs it, then toom-4
+	// and the transform, the last with an unbalanced operand. every size runs on both kernel
+	// paths
+	const size_t sizes[][2] = { { 100, 100 }, { 300, 300 }, { 1000, 999 }, { 5000, 5000 },
+								{ 20000, 7000 } };
+	for(const auto& [an, bn] : sizes) {
+		const UnsignedBigInt a = random_bignum(gen, an);
+		const UnsignedBigInt b = random_bignum(gen, bn);
+		const UnsignedBigInt expected = a * b;
+		const UnsignedBigInt expected_square = a.square();
+
+		for_each_kernel_path([&] {
+			for(size_t grain : { size_t(16), size_t(64), ParallelScope::DEFAULT_GRAIN }) {
+				ParallelScope scope(pool, grain);
+				ASSERT_TRUE(a * b == expected) << an << " " << bn << " " << grain;
+				ASSERT_TRUE(a.square() == expected_square) << an << " " << grain;
+			}
+		});
+	}
+}
+
+TEST(ParallelMultiplication, ConcurrentCallers) {
+	// products started on several threads share one pool
+	ThreadPool pool(3);
+	std::mt19937_64 gen(2);
+	const UnsignedBigInt a = random_bignum(gen, 6000);
+	const UnsignedBigInt b = random_bignum(gen, 6000);
+	const UnsignedBigInt expected = a * b;
+
+	std::atomic<size_t> matches = 0;
+	std::vector<std::thread> callers;
+	for(size_t i = 0; i < 3; i++) {
+		callers.emplace_back([&]() {
+			ParallelScope scope(pool, 64);
+			for(size_t j = 0; j < 3; j++) {
+				matches += a * b == expected;
+			}
+		});
+	}
+	for(std::thread& caller : callers) {
+		caller.join();
+	}
+	ASSERT_EQ(matches, 9);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
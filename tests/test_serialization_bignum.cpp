@@ -0,0 +1,169 @@
+#include "include/bignum.hpp"
+#include "include/bignum_view.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+static std::vector<UnsignedBigInt> sample_values() {
+	std::mt19937_64 gen(1);
+	std::vector<UnsignedBigInt> ret = { UnsignedBigInt(0), UnsignedBigInt(1),
+										UnsignedBigInt(~uint64_t(0)), UnsignedBigInt(1) << 64 };
+	for(size_t limbs : { 2, 3, 15, 16, 127, 128, 129, 1000 }) {
+		ret.push_back(random_bignum(gen, limbs));
+	}
+	return ret;
+}
+
+TEST(Serialization, RoundTrips) {
+	for(const UnsignedBigInt& value : sample_values()) {
+		const std::vector<uint8_t> bytes = value.serialize();
+		ASSERT_EQ(bytes.size(), value.serialized_size());
+		size_t consumed = 0;
+		ASSERT_TRUE(UnsignedBigInt::deserialize(bytes, &consumed) == value) << value.digits();
+		ASSERT_EQ(consumed, bytes.size());
+	}
+}
+
+TEST(Serialization, Layout) {
+	ASSERT_EQ(UnsignedBigInt(0).serialize(), std::vector<uint8_t>({ 1, 0 }));
+	ASSERT_EQ(UnsignedBigInt(0x0102).serialize(),
+			  std::vector<uint8_t>({ 1, 1, 0x02, 0x01, 0, 0, 0, 0, 0, 0 }));
+
+	// 130 limbs need a second varint byte, the rest is the limbs themselves
+	std::mt19937_64 gen(2);
+	const UnsignedBigInt value = random_bignum(gen, 130);
+	const std::vector<uint8_t> bytes = value.serialize();
+	ASSERT_EQ(bytes.size(), 3 + 130 * 8);
+	ASSERT_EQ(bytes[1], 0x82);
+	ASSERT_EQ(bytes[2], 0x01);
+}
+
+TEST(Serialization, BackToBack) {
+	const std::vector<UnsignedBigInt> values = sample_values();
+	std::vector<uint8_t> buffer;
+	for(const UnsignedBigInt& value : values) {
+		const size_t offset = buffer.size();
+		buffer.resize(offset + value.serialized_size());
+		ASSERT_EQ(value.serialize(buffer.data() + offset), value.serialized_size());
+	}
+
+	std::span<const uint8_t> rest(buffer);
+	for(const UnsignedBigInt& value : values) {
+		size_t consumed = 0;
+		ASSERT_TRUE(UnsignedBigIntView::decode(rest, &consumed) == value);
+		rest = rest.subspan(consumed);
+	}
+	ASSERT_TRUE(rest.empty());
+}
+
+TEST(Serialization, RejectsMalformed) {
+	const std::vector<std::vector<uint8_t>> malformed = {
+		{},
+		{ 2, 0 }, // unknown version
+		{ 1 }, // no length
+		{ 1, 0x80 }, // the varint goes on past the end
+		{ 1, 0x80, 0x00 }, // a redundant zero group
+		{ 1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02 }, // above 2^64
+		{ 1, 1, 1, 2, 3 }, // fewer than eight limb bytes
+		{ 1, 1, 0, 0, 0, 0, 0, 0, 0, 0 }, // a zero top limb
+		{ 1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0 }, // limbs past the end
+	};
+	for(const std::vector<uint8_t>& bytes : malformed) {
+		ASSERT_THROW(UnsignedBigInt::deserialize(bytes), BigNumInvalidEncodingException)
+			<< bytes.size();
+	}
+}
+
+TEST(Serialization, Bytes) {
+	const UnsignedBigInt value = (UnsignedBigInt(0x0102) << 64) + uint64_t(0x0304);
+	std::vector<uint8_t> big(10, 0);
+	big[0] = 0x01;
+	big[1] = 0x02;
+	big[8] = 0x03;
+	big[9] = 0x04;
+	ASSERT_EQ(value.to_bytes(), big);
+	ASSERT_EQ(value.to_bytes(std::endian::little), std::vector<uint8_t>(big.rbegin(), big.rend()));
+	ASSERT_TRUE(UnsignedBigInt(0).to_bytes().empty());
+
+	for(const UnsignedBigInt& sample : sample_values()) {
+		for(std::endian order : { std::endian::big, std::endian::little }) {
+			std::vector<uint8_t> bytes = sample.to_bytes(order);
+			ASSERT_TRUE(UnsignedBigInt::from_bytes(bytes, order) == sample);
+			// leading zeros in either order
+			bytes.insert(order == std::endian::big ? bytes.begin() : bytes.end(), 9, 0);
+			ASSERT_TRUE(UnsignedBigInt::from_bytes(bytes, order) == sample);
+		}
+	}
+}
+
+TEST(View, ComparesInPlace) {
+	const std::vector<UnsignedBigInt> values = sample_values();
+	for(size_t offset : { 0, 1, 3 }) {
+		for(const UnsignedBigInt& lhs : values) {
+			// an encoding at each alignment, read without copying the limbs
+			std::vector<uint8_t> buffer(offset + lhs.serialized_size() + 8);
+			lhs.serialize(buffer.data() + offset);
+			const UnsignedBigIntView view =
+				UnsignedBigIntView::decode(std::span(buffer).subspan(offset));
+			ASSERT_EQ(view.digits(), lhs.digits());
+			ASSERT_TRUE(UnsignedBigInt(view) == lhs);
+			for(const UnsignedBigInt& rhs : values) {
+				ASSERT_EQ(view <=> rhs, lhs <=> rhs);
+				ASSERT_EQ(view == rhs, lhs == rhs);
+				ASSERT_EQ(rhs < view, rhs < lhs);
+			}
+		}
+	}
+}
+
+TEST(View, ReadOnlyOperands) {
+	std::mt19937_64 gen(3);
+	for(size_t limbs : { 1, 5, 40, 300 }) {
+		const UnsignedBigInt a = random_bignum(gen, limbs + 3);
+		const UnsignedBigInt b = random_bignum(gen, limbs);
+		for(size_t offset : { 0, 1 }) {
+			std::vector<uint8_t> buffer(offset + b.serialized_size());
+			b.serialize(buffer.data() + offset);
+			const UnsignedBigIntView view =
+				UnsignedBigIntView::decode(std::span(buffer).subspan(offset));
+
+			UnsignedBigInt sum = a;
+			ASSERT_TRUE((sum += view) == a + b) << limbs << " " << offset;
+			UnsignedBigInt difference = a;
+			ASSERT_TRUE((difference -= view) == a - b) << limbs << " " << offset;
+			UnsignedBigInt product = a;
+			ASSERT_TRUE((product *= view) == a * b) << limbs << " " << offset;
+			UnsignedBigInt small = b - 1;
+			ASSERT_THROW(small -= view, BigNumUnderflowException);
+			ASSERT_TRUE(small == b - 1);
+		}
+	}
+}
+
+TEST(View, OperandOverlapsTarget) {
+	std::mt19937_64 gen(4);
+	const UnsignedBigInt a = random_bignum(gen, 20);
+	UnsignedBigInt x = a;
+	x += UnsignedBigIntView(x);
+	ASSERT_TRUE(x == a + a);
+	x = a;
+	x -= UnsignedBigIntView(x);
+	ASSERT_TRUE(x == UnsignedBigInt(0));
+	x = a;
+	x *= UnsignedBigIntView(x);
+	ASSERT_TRUE(x == a.square());
+
+	// raw limbs with leading zeros, and no limbs at all for zero
+	const uint64_t limbs[] = { 7, 0, 0 };
+	ASSERT_EQ(UnsignedBigIntView(limbs, 3).digits(), 1);
+	ASSERT_TRUE(UnsignedBigIntView(limbs, 3) == UnsignedBigInt(7));
+	ASSERT_TRUE(UnsignedBigIntView(limbs, 0) == UnsignedBigInt(0));
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#include "include/bigint.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+TEST(BigInt, Construction) {
+	ASSERT_EQ(BigInt(-42).to_string(), "-42");
+	ASSERT_EQ(BigInt(42).to_string(), "42");
+	ASSERT_EQ(BigInt(std::numeric_limits<int64_t>::min()).to_string(), "-9223372036854775808");
+	ASSERT_EQ(BigInt(std::string("-123456789012345678901234567890")).to_string(),
+			  "-123456789012345678901234567890");
+	ASSERT_EQ(BigInt(std::string("+17")).to_string(), "17");
+
+	// zero never carries a sign
+	ASSERT_EQ(BigInt(std::string("-0")).sign(), 0);
+	ASSERT_FALSE(BigInt(UnsignedBigInt(0), true).is_negative());
+	ASSERT_EQ((-BigInt(0)).to_string(), "0");
+}
+
+TEST(BigInt, SmallArithmeticMatchesBuiltin) {
+	std::mt19937_64 gen(1);
+	std::uniform_int_distribution<int64_t> dist(-1000000000, 1000000000);
+	for(int i = 0; i < 2000; i++) {
+		const int64_t a = dist(gen);
+		const int64_t b = i % 7 ? dist(gen) : a;
+		ASSERT_TRUE(BigInt(a) + BigInt(b) == BigInt(a + b)) << a << " " << b;
+		ASSERT_TRUE(BigInt(a) - BigInt(b) == BigInt(a - b)) << a << " " << b;
+		ASSERT_TRUE(BigInt(a) * BigInt(b) == BigInt(a * b)) << a << " " << b;
+		ASSERT_EQ(BigInt(a) < BigInt(b), a < b) << a << " " << b;
+		ASSERT_EQ(BigInt(a) == BigInt(b), a == b) << a << " " << b;
+		if(b != 0) {
+			ASSERT_TRUE(BigInt(a) / BigInt(b) == BigInt(a / b)) << a << " " << b;
+			ASSERT_TRUE(BigInt(a) % BigInt(b) == BigInt(a % b)) << a << " " << b;
+		}
+	}
+}
+
+TEST(BigInt, SubtractionCrossesZero) {
+	std::mt19937_64 gen(2);
+	for(size_t n : { 1, 2, 9, 40 }) {
+		const UnsignedBigInt small = random_bignum(gen, n);
+		const UnsignedBigInt large = small + random_bignum(gen, n + 1);
+
+		BigInt x = small;
+		x -= large;
+		ASSERT_TRUE(x.is_negative()) << n;
+		ASSERT_TRUE(x.magnitude() == large - small) << n;
+
+		x += large;
+		ASSERT_TRUE(x == BigInt(small)) << n;
+
+		// equal lengths, so the sign only shows up as a borrow out of the top limb
+		const UnsignedBigInt other = random_bignum(gen, n);
+		BigInt y = small;
+		y -= other;
+		ASSERT_EQ(y.is_negative(), small < other) << n;
+		ASSERT_TRUE(y + BigInt(other) == BigInt(small)) << n;
+
+		BigInt z = small;
+		z -= z;
+		ASSERT_EQ(z.sign(), 0) << n;
+	}
+}
+
+TEST(BigInt, DivisionModes) {
+	// quotient * divisor + remainder == dividend in both modes, with the remainder taking the
+	// dividend's sign when truncating and the divisor's when flooring
+	for(int a : { 7, -7, 6, -6, 0 }) {
+		for(int b : { 2, -2, 3, -3 }) {
+			const auto [tq, tr] = BigInt(a).divmod(BigInt(b), DivisionMode::TRUNCATE);
+			ASSERT_TRUE(tq == BigInt(a / b)) << a << " " << b;
+			ASSERT_TRUE(tr == BigInt(a % b)) << a << " " << b;
+
+			const auto [fq, fr] = BigInt(a).divmod(BigInt(b), DivisionMode::FLOOR);
+			const int floor_r = ((a % b) + b) % b;
+			ASSERT_TRUE(fr == BigInt(floor_r)) << a << " " << b;
+			ASSERT_TRUE(fq == BigInt((a - floor_r) / b)) << a << " " << b;
+		}
+	}
+
+	std::mt19937_64 gen(3);
+	const BigInt n(random_bignum(gen, 30), true);
+	const BigInt d(random_bignum(gen, 12));
+	for(DivisionMode mode : { DivisionMode::TRUNCATE, DivisionMode::FLOOR }) {
+		const auto [q, r] = n.divmod(d, mode);
+		ASSERT_TRUE(q * d + r == n);
+	}
+
+	ASSERT_THROW(n.divmod(BigInt(0)), BigNumDivideByZeroException);
+}
+
+TEST(BigInt, Ordering) {
+	const BigInt a(std::string("-100000000000000000000000"));
+	const BigInt b(std::string("-99999999999999999999999"));
+	const BigInt c(std::string("5"));
+	ASSERT_TRUE(a < b);
+	ASSERT_TRUE(b < c);
+	ASSERT_TRUE(a <= a);
+	ASSERT_TRUE(c > a);
+	ASSERT_TRUE(c >= b);
+	ASSERT_TRUE(a != b);
+	ASSERT_EQ(a.sign(), -1);
+	ASSERT_EQ(c.sign(), 1);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
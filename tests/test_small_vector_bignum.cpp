@@ -0,0 +1,135 @@
+#include "include/bignum.hpp"
+#include "include/small_vector.tpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+typedef SmallVector<uint64_t, 4> Vector;
+
+static void fill_sequence(Vector& v, size_t n) {
+	v.clear();
+	for(size_t i = 0; i < n; i++) {
+		v.push_back(i);
+	}
+}
+
+static void expect_sequence(const Vector& v, size_t n) {
+	ASSERT_EQ(v.size(), n);
+	for(size_t i = 0; i < n; i++) {
+		ASSERT_EQ(v[i], i) << i;
+	}
+}
+
+TEST(SmallVector, StaysInline) {
+	Vector v(4, 7);
+	ASSERT_TRUE(v.is_inline());
+	ASSERT_EQ(v.capacity(), 4);
+	ASSERT_EQ(v[3], 7);
+
+	v.resize(2);
+	v.resize(4);
+	ASSERT_TRUE(v.is_inline());
+	ASSERT_EQ(v[1], 7);
+	ASSERT_EQ(v[2], 0);
+}
+
+TEST(SmallVector, SpillsToHeap) {
+	Vector v;
+	fill_sequence(v, 100);
+	ASSERT_FALSE(v.is_inline());
+	expect_sequence(v, 100);
+
+	v.resize(200, 1);
+	ASSERT_EQ(v[99], 99);
+	ASSERT_EQ(v[199], 1);
+}
+
+TEST(SmallVector, PushBackOwnElement) {
+	Vector v;
+	fill_sequence(v, 4);
+	v.push_back(v[3]);
+	ASSERT_EQ(v[4], 3);
+}
+
+TEST(SmallVector, CopyAndMove) {
+	for(size_t n : { 3, 50 }) {
+		Vector v;
+		fill_sequence(v, n);
+
+		Vector copy(v);
+		expect_sequence(copy, n);
+		Vector assigned;
+		assigned = v;
+		expect_sequence(assigned, n);
+
+		Vector moved(std::move(copy));
+		expect_sequence(moved, n);
+		Vector move_assigned(100, 5);
+		move_assigned = std::move(assigned);
+		expect_sequence(move_assigned, n);
+	}
+}
+
+TEST(SmallVector, Assign) {
+	Vector source;
+	fill_sequence(source, 30);
+	Vector v(2, 9);
+	v.assign(source.begin(), source.begin() + 30);
+	expect_sequence(v, 30);
+	v.assign(source.begin(), source.begin() + 3);
+	expect_sequence(v, 3);
+}
+
+/// @brief std::allocator that throws std::bad_alloc while fail is set
+template <typename T>
+struct FailingAllocator : std::allocator<T> {
+	inline static bool fail = false;
+
+	T* allocate(size_t n) {
+		if(fail) {
+			throw std::bad_alloc();
+		}
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+TEST(SmallVector, AssignKeepsElementsWhenAllocationFails) {
+	SmallVector<uint64_t, 4, FailingAllocator<uint64_t>> v;
+	for(uint64_t i = 0; i < 10; i++) {
+		v.push_back(i);
+	}
+	std::vector<uint64_t> source(50, 1);
+
+	FailingAllocator<uint64_t>::fail = true;
+	ASSERT_THROW(v.assign(source.begin(), source.end()), std::bad_alloc);
+	FailingAllocator<uint64_t>::fail = false;
+
+	ASSERT_FALSE(v.is_inline());
+	ASSERT_EQ(v.size(), 10);
+	ASSERT_GE(v.capacity(), v.size());
+	for(size_t i = 0; i < 10; i++) {
+		ASSERT_EQ(v[i], i) << i;
+	}
+}
+
+TEST(SmallVector, BignumsCrossingTheInlineLimit) {
+	// values grow from inline storage onto the heap and shrink back through every operator
+	UnsignedBigInt a = 1;
+	for(int i = 0; i < 20; i++) {
+		a *= UnsignedBigInt(std::numeric_limits<uint64_t>::max());
+	}
+	UnsignedBigInt b = a;
+	b >>= 64 * 15;
+	ASSERT_TRUE((a >> (64 * 15)) == b);
+	ASSERT_TRUE((a / b) * b + a % b == a);
+	ASSERT_EQ((a - a).to_string(), "0");
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,65 @@
+#include "include/bignum.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+/// a distinct copy keeps the reference product on the general multiplication path
+static void check_square(const UnsignedBigInt& a) {
+	UnsignedBigInt copy = a + 1;
+	copy -= 1;
+	UnsignedBigInt expected = a * copy;
+
+	for_each_kernel_path([&] {
+		ASSERT_TRUE(a.square() == expected) << a.digits();
+
+		UnsignedBigInt b = a;
+		b *= b;
+		ASSERT_TRUE(b == expected) << a.digits();
+	});
+}
+
+TEST(Square, AllTiers) {
+	std::mt19937_64 gen(42);
+	for(size_t n : { 1, 2, 3, 31, 47, 48, 49, 100, 191, 192, 300, 511, 512, 700, 4096, 5000 }) {
+		check_square(from_limbs(random_limbs(gen, n)));
+	}
+}
+
+TEST(Square, AllOnes) {
+	for(size_t n : { 1, 60, 250, 600, 4100 }) {
+		check_square(from_limbs(std::vector<uint64_t>(n, std::numeric_limits<uint64_t>::max())));
+	}
+}
+
+TEST(Square, Small) {
+	ASSERT_EQ(UnsignedBigInt(0).square().to_string(), "0");
+	ASSERT_EQ(UnsignedBigInt(1).square().to_string(), "1");
+	ASSERT_EQ(UnsignedBigInt(uint64_t(4294967296ull)).square().to_string(), "18446744073709551616");
+	ASSERT_EQ(UnsignedBigInt(0).square().digits(), 1);
+}
+
+TEST(Square, Power) {
+	UnsignedBigInt three = 3;
+	ASSERT_EQ((three ^ UnsignedBigInt(0)).to_string(), "1");
+	ASSERT_EQ((three ^ UnsignedBigInt(1)).to_string(), "3");
+	ASSERT_EQ((three ^ UnsignedBigInt(45)).to_string(), "2954312706550833698643");
+}
+
+TEST(Square, ModulusExp) {
+	UnsignedBigInt base = 4;
+	ASSERT_EQ(base.modulus_exp(UnsignedBigInt(13), UnsignedBigInt(497)).to_string(), "445");
+	ASSERT_EQ(base.modulus_exp(UnsignedBigInt(0), UnsignedBigInt(497)).to_string(), "1");
+	ASSERT_EQ(base.modulus_exp(UnsignedBigInt(5), UnsignedBigInt(1)).to_string(), "0");
+
+	// fermat: a^(p - 1) = 1 mod p for the mersenne prime 2^61 - 1
+	UnsignedBigInt p = (UnsignedBigInt(1) << 61) - 1;
+	UnsignedBigInt a = 123456789;
+	ASSERT_EQ(a.modulus_exp(p - 1, p).to_string(), "1");
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -41,6 +41,53 @@ TEST(Init, SubtractionRepeated) {
 	ASSERT_EQ(a.to_string(), answer.to_string());
 }
 
+TEST(Init, SubtractionRenormalizes) {
+	// the difference loses several leading limbs at once
+	UnsignedBigInt a = (UnsignedBigInt(1) << 320) + 5;
+	UnsignedBigInt b = UnsignedBigInt(1) << 320;
+	a -= b;
+	ASSERT_EQ(a.digits(), 1);
+	ASSERT_TRUE(a == UnsignedBigInt(5));
+
+	UnsignedBigInt c = UnsignedBigInt(1) << 128;
+	c -= 1;
+	ASSERT_EQ(c.digits(), 2);
+	c -= c;
+	ASSERT_EQ(c.digits(), 1);
+	ASSERT_EQ(c.to_string(), "0");
+}
+
+TEST(Init, TrySub) {
+	const UnsignedBigInt small = std::string("98790342802340927849023849089");
+	const UnsignedBigInt large = std::string("890534790435890345890345898427502473590237590283");
+
+	UnsignedBigInt a = small;
+	ASSERT_FALSE(a.try_sub(large));
+	ASSERT_TRUE(a == small);
+
+	// same length, the failure only shows as a borrow out of the top limb
+	UnsignedBigInt b = small;
+	ASSERT_FALSE(b.try_sub(small + 1));
+	ASSERT_TRUE(b == small);
+	ASSERT_FALSE(UnsignedBigInt(3).try_sub(uint64_t(4)));
+
+	UnsignedBigInt c = large;
+	ASSERT_TRUE(c.try_sub(small));
+	ASSERT_TRUE(c + small == large);
+	ASSERT_TRUE(c.try_sub(uint64_t(89)));
+	ASSERT_TRUE(c + small + 89 == large);
+}
+
+TEST(Init, ThreeWayCompare) {
+	const UnsignedBigInt a = std::string("890534790435890345890345898427502473590237590283");
+	const UnsignedBigInt b = a + 1;
+	ASSERT_EQ(a <=> b, std::strong_ordering::less);
+	ASSERT_EQ(b <=> a, std::strong_ordering::greater);
+	ASSERT_EQ(a <=> UnsignedBigInt(a), std::strong_ordering::equal);
+	ASSERT_EQ(UnsignedBigInt(7) <=> a, std::strong_ordering::less);
+	ASSERT_TRUE(a <= b && b >= a && !(a > b) && !(b < a));
+}
+
 int main(int argc, char** argv) {
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
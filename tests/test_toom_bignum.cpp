@@ -0,0 +1,58 @@
+#include "include/bignum.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+TEST(Toom, Toom3Balanced) {
+	for(size_t n : { 192, 193, 194, 195, 300, 511 }) {
+		check_product(n, n, n);
+	}
+}
+
+TEST(Toom, Toom4Balanced) {
+	for(size_t n : { 512, 513, 514, 515, 777, 1600 }) {
+		check_product(n, n, n);
+	}
+}
+
+TEST(Toom, Unbalanced) {
+	check_product(1000, 200, 1);
+	check_product(2000, 600, 2);
+	check_product(600, 599, 3);
+}
+
+TEST(Toom, AllOnes) {
+	// maximal evaluation points push every interpolation intermediate to its bound
+	for(size_t n : { 250, 700 }) {
+		std::vector<uint64_t> limbs(n, std::numeric_limits<uint64_t>::max());
+		UnsignedBigInt a = from_limbs(limbs);
+		UnsignedBigInt expected = reference_product(a, limbs);
+
+		for_each_kernel_path([&] { ASSERT_TRUE(a * a == expected) << n; });
+	}
+}
+
+TEST(Toom, SparseLimbs) {
+	// zero middle parts make a(-1) and a(-2) negative for one operand only
+	for(size_t n : { 300, 1000 }) {
+		std::vector<uint64_t> a_limbs(n, 0);
+		std::vector<uint64_t> b_limbs(n, 0);
+		for(size_t i = 0; i < n; i++) {
+			a_limbs[i] = (i * 4 / n) % 2 ? std::numeric_limits<uint64_t>::max() : 0;
+			b_limbs[i] = (i * 4 / n) % 2 ? 0 : std::numeric_limits<uint64_t>::max() - i;
+		}
+		a_limbs.back() = b_limbs.back() = 1;
+
+		UnsignedBigInt a = from_limbs(a_limbs);
+		UnsignedBigInt b = from_limbs(b_limbs);
+		UnsignedBigInt expected = reference_product(a, b_limbs);
+		for_each_kernel_path([&] { ASSERT_TRUE(a * b == expected) << n; });
+	}
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
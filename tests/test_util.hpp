@@ -0,0 +1,119 @@
+#pragma once
+
+#include "include/bignum.hpp"
+#include "include/ifma.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/// @brief value of limbs, least significant first, built one limb at a time so it never depends
+/// on the kernels under test
+inline UnsignedBigInt from_limbs(const std::vector<uint64_t>& limbs) {
+	UnsignedBigInt ret = 0;
+	for(size_t i = limbs.size(); i > 0; i--) {
+		ret <<= 64;
+		ret += limbs[i - 1];
+	}
+	return ret;
+}
+
+/// @brief n > 0 random limbs whose top one has its high bit set, a normalized divisor or an
+/// operand of exactly n limbs for the multiplication kernels
+inline std::vector<uint64_t> random_limbs(std::mt19937_64& gen, size_t n) {
+	std::vector<uint64_t> limbs(n);
+	for(auto& limb : limbs) {
+		limb = gen();
+	}
+	limbs.back() |= 1ull << 63;
+	return limbs;
+}
+
+/// @brief random value of exactly n limbs, zero for n = 0. only the top limb is forced nonzero,
+/// so its leading zero bits still vary
+inline UnsignedBigInt random_bignum(std::mt19937_64& gen, size_t n) {
+	std::vector<uint64_t> limbs(n);
+	for(auto& limb : limbs) {
+		limb = gen();
+	}
+	if(n > 0) {
+		limbs.back() |= 1;
+	}
+	return from_limbs(limbs);
+}
+
+/// @brief n random decimal digits. a leading '0' is replaced by '7', so the value has exactly n
+/// significant digits while its first digit still varies. empty for n = 0
+inline std::string random_digits(std::mt19937_64& gen, size_t n) {
+	std::string ret(n, '0');
+	for(char& digit : ret) {
+		digit = static_cast<char>('0' + gen() % 10);
+	}
+	if(n > 0 && ret[0] == '0') {
+		ret[0] = '7';
+	}
+	return ret;
+}
+
+/// @brief a * b multiplied one limb of b at a time, so the reference never touches the
+/// recursive kernels
+inline UnsignedBigInt reference_product(const UnsignedBigInt& a, const std::vector<uint64_t>& b) {
+	UnsignedBigInt ret = 0;
+	for(size_t i = 0; i < b.size(); i++) {
+		ret += (a * b[i]) << (64 * i);
+	}
+	return ret;
+}
+
+/// @brief runs the scalar kernels for the lifetime of the guard
+class ScalarKernels {
+public:
+	ScalarKernels()
+		: m_previous(ifma::enabled()) {
+		ifma::set_enabled(false);
+	}
+
+	~ScalarKernels() {
+		ifma::set_enabled(m_previous);
+	}
+
+	ScalarKernels(const ScalarKernels&) = delete;
+	ScalarKernels& operator=(const ScalarKernels&) = delete;
+
+private:
+	bool m_previous;
+};
+
+/// @brief runs check on the kernels this cpu picks, then once more on the scalar ones where the
+/// IFMA kernel is on. it takes the base case up to IFMA_KARATSUBA_THRESHOLD limbs, so only the
+/// scalar run reaches karatsuba and toom-3 at those sizes
+template <typename Check>
+void for_each_kernel_path(Check check) {
+	check();
+	if(ifma::enabled() && !::testing::Test::HasFatalFailure()) {
+		SCOPED_TRACE("scalar kernels");
+		ScalarKernels scalar;
+		check();
+	}
+}
+
+/// @brief checks a * b and b * a for random operands of exactly an and bn limbs against
+/// reference_product, on every kernel path
+inline void check_product(size_t an, size_t bn, uint64_t seed) {
+	std::mt19937_64 gen(seed);
+	std::vector<uint64_t> a_limbs = random_limbs(gen, an);
+	std::vector<uint64_t> b_limbs = random_limbs(gen, bn);
+
+	UnsignedBigInt a = from_limbs(a_limbs);
+	UnsignedBigInt b = from_limbs(b_limbs);
+	UnsignedBigInt expected = reference_product(a, b_limbs);
+
+	ASSERT_EQ(a.digits(), an);
+	ASSERT_EQ(b.digits(), bn);
+	for_each_kernel_path([&] {
+		ASSERT_TRUE(a * b == expected) << an << "x" << bn;
+		ASSERT_TRUE(b * a == expected) << bn << "x" << an;
+	});
+}
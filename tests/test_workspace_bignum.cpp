@@ -0,0 +1,170 @@
+#include "include/bignum.hpp"
+#include "include/workspace.hpp"
+#include "tests/test_util.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+/// @brief product of values[lo..hi] by splitting in halves, the shape subquadratic conversions
+/// and factorials use
+static UnsignedBigInt product_tree(
+	const std::vector<UnsignedBigInt>& values, size_t lo, size_t hi) {
+	if(hi - lo == 1) {
+		return values[lo];
+	}
+	const size_t mid = lo + (hi - lo) / 2;
+	return product_tree(values, lo, mid) * product_tree(values, mid, hi);
+}
+
+TEST(Workspace, FramesRewind) {
+	Workspace workspace;
+	{
+		Workspace::Frame outer(workspace);
+		uint64_t* a = outer.take(3);
+		ASSERT_EQ(reinterpret_cast<uintptr_t>(a) % 64, 0);
+		ASSERT_EQ(workspace.used(), 8);
+		{
+			Workspace::Frame inner(workspace);
+			uint64_t* b = inner.take(16);
+			ASSERT_EQ(b, a + 8);
+			ASSERT_EQ(workspace.used(), 24);
+		}
+		ASSERT_EQ(workspace.used(), 8);
+
+		// the inner frame's limbs are handed out again
+		Workspace::Frame again(workspace);
+		ASSERT_EQ(again.take(1), a + 8);
+	}
+	ASSERT_EQ(workspace.used(), 0);
+	ASSERT_EQ(workspace.peak(), 24);
+
+	workspace.reset_peak();
+	ASSERT_EQ(workspace.peak(), 0);
+}
+
+TEST(Workspace, GrowsWithoutMovingLiveLimbs) {
+	Workspace workspace(64);
+	ASSERT_EQ(workspace.capacity(), 64);
+	{
+		Workspace::Frame frame(workspace);
+		uint64_t* a = frame.take(64);
+		for(size_t i = 0; i < 64; i++) {
+			a[i] = i;
+		}
+		uint64_t* b = frame.take(Workspace::MIN_CHUNK * 4);
+		b[0] = 1;
+		for(size_t i = 0; i < 64; i++) {
+			ASSERT_EQ(a[i], i);
+		}
+	}
+	ASSERT_GT(workspace.capacity(), 64 + Workspace::MIN_CHUNK * 4 - 1);
+
+	// once idle the chunks merge, so the same demand fits in one block
+	const size_t capacity = workspace.capacity();
+	{
+		Workspace::Frame frame(workspace);
+		uint64_t* a = frame.take(64);
+		uint64_t* b = frame.take(Workspace::MIN_CHUNK * 4);
+		ASSERT_EQ(b, a + 64);
+	}
+	ASSERT_EQ(workspace.capacity(), capacity);
+
+	workspace.release();
+	ASSERT_EQ(workspace.capacity(), 0);
+}
+
+TEST(Workspace, Scopes) {
+	Workspace& own = current_workspace();
+	Workspace outer;
+	Workspace inner;
+	{
+		WorkspaceScope outer_scope(outer);
+		ASSERT_EQ(&current_workspace(), &outer);
+		{
+			WorkspaceScope inner_scope(inner);
+			ASSERT_EQ(&current_workspace(), &inner);
+		}
+		ASSERT_EQ(&current_workspace(), &outer);
+	}
+	ASSERT_EQ(&current_workspace(), &own);
+
+	Workspace* other = nullptr;
+	std::thread([&other] { other = &current_workspace(); }).join();
+	ASSERT_NE(other, &own);
+}
+
+TEST(Workspace, KernelsReturnEverything) {
+	std::mt19937_64 gen(1);
+	const UnsignedBigInt a = random_bignum(gen, 700);
+	const UnsignedBigInt b = random_bignum(gen, 300);
+
+	Workspace workspace;
+	WorkspaceScope scope(workspace);
+	const UnsignedBigInt product = a * b;
+	const auto [q, r] = product.divmod(b + 1);
+	ASSERT_TRUE(q * (b + 1) + r == product);
+	ASSERT_FALSE(product.to_string().empty());
+	ASSERT_EQ(workspace.used(), 0);
+	ASSERT_GT(workspace.peak(), a.digits() + b.digits());
+}
+
+TEST(Workspace, SizedOnceForModexp) {
+	std::mt19937_64 gen(2);
+	const UnsignedBigInt base = random_bignum(gen, 32);
+	const UnsignedBigInt exp = random_bignum(gen, 32);
+	const UnsignedBigInt odd = (random_bignum(gen, 32) << 1) + 1;
+	const UnsignedBigInt even = random_bignum(gen, 32) << 1;
+	for(const UnsignedBigInt& mod : { odd, even }) {
+		Workspace probe;
+		UnsignedBigInt expected;
+		{
+			WorkspaceScope scope(probe);
+			expected = base.modulus_exp(exp, mod);
+		}
+
+		// a workspace of the measured size serves later runs without growing
+		Workspace sized(probe.peak());
+		const size_t capacity = sized.capacity();
+		WorkspaceScope scope(sized);
+		for(int i = 0; i < 3; i++) {
+			ASSERT_TRUE(base.modulus_exp(exp, mod) == expected);
+		}
+		ASSERT_EQ(sized.capacity(), capacity);
+		ASSERT_EQ(sized.peak(), probe.peak());
+	}
+}
+
+TEST(Workspace, SizedOnceForProductTree) {
+	std::mt19937_64 gen(3);
+	std::vector<UnsignedBigInt> values;
+	for(size_t i = 0; i < 64; i++) {
+		values.push_back(random_bignum(gen, 40));
+	}
+
+	Workspace probe;
+	UnsignedBigInt expected;
+	{
+		WorkspaceScope scope(probe);
+		expected = product_tree(values, 0, values.size());
+	}
+
+	Workspace sized(probe.peak());
+	const size_t capacity = sized.capacity();
+	WorkspaceScope scope(sized);
+	ASSERT_TRUE(product_tree(values, 0, values.size()) == expected);
+	ASSERT_EQ(sized.capacity(), capacity);
+
+	UnsignedBigInt serial = 1;
+	for(const UnsignedBigInt& value : values) {
+		serial *= value;
+	}
+	ASSERT_TRUE(serial == expected);
+}
+
+int main(int argc, char** argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}